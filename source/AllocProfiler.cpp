@@ -0,0 +1,276 @@
+#include "AllocProfiler.h"
+#include <QStringList>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+namespace {
+
+// Plain thread_local int: readable from inside the allocator without allocating
+thread_local int currentPhase = AllocProfiler::Other;
+
+std::atomic<quint64> rounds{0};
+std::atomic<quint64> allocations[AllocProfiler::PhaseCount];
+std::atomic<quint64> allocatedBytes[AllocProfiler::PhaseCount];
+
+} // namespace
+
+// Enter a phase for the current thread
+AllocProfiler::Scope::Scope(Phase phase) : previous(currentPhase) {
+    currentPhase = phase;
+}
+
+// Leave the phase
+AllocProfiler::Scope::~Scope() {
+    currentPhase = previous;
+}
+
+// Count one allocation against the thread's current phase
+void AllocProfiler::record(std::size_t bytes) {
+    allocations[currentPhase].fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes[currentPhase].fetch_add(bytes, std::memory_order_relaxed);
+}
+
+// Count one finished round
+void AllocProfiler::endRound() {
+    rounds.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Read all counters
+AllocProfiler::Snapshot AllocProfiler::snapshot() {
+    Snapshot totals;
+    totals.rounds = rounds.load(std::memory_order_relaxed);
+    for (int p = 0; p < PhaseCount; ++p) {
+        totals.allocations[p] = allocations[p].load(std::memory_order_relaxed);
+        totals.bytes[p] = allocatedBytes[p].load(std::memory_order_relaxed);
+    }
+    return totals;
+}
+
+// Format the per-round averages, e.g. "Allocations/round (120 rounds): deal 4.0 (96 B), ..."
+QString AllocProfiler::report() {
+    if (!enabled())
+        return QString();
+
+    Snapshot totals = snapshot();
+    const char* names[PhaseCount] = { "other", "deal", "swap", "evaluate", "render" };
+    double perRound = totals.rounds ? 1.0 / totals.rounds : 0.0;
+
+    QStringList phases;
+    for (int p = 0; p < PhaseCount; ++p) {
+        phases << QString("%1 %2 (%3 B)")
+                      .arg(names[p])
+                      .arg(totals.allocations[p] * perRound, 0, 'f', 1)
+                      .arg(totals.bytes[p] * perRound, 0, 'f', 0);
+    }
+    return QString("Allocations/round (%1 rounds): %2").arg(totals.rounds).arg(phases.join(", "));
+}
+
+#ifdef POKER_ALLOC_PROFILE
+
+namespace {
+
+// Print the report when the process exits
+struct ExitReport {
+    ~ExitReport() {
+        std::fprintf(stderr, "%s\n", qPrintable(AllocProfiler::report()));
+    }
+} exitReport;
+
+} // namespace
+
+#if defined(__GLIBC__)
+
+// glibc: interpose malloc and its aligned variants, which also catches Qt's
+// containers and strings (they allocate through malloc, not operator new).
+// realloc only counts when it hands back a different block: shrinking or
+// growing in place allocates nothing.
+extern "C" {
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t count, std::size_t size);
+void* __libc_realloc(void* ptr, std::size_t size);
+void* __libc_memalign(std::size_t alignment, std::size_t size);
+void* __libc_valloc(std::size_t size);
+void* __libc_pvalloc(std::size_t size);
+void __libc_free(void* ptr);
+
+void* malloc(std::size_t size) {
+    AllocProfiler::record(size);
+    return __libc_malloc(size);
+}
+
+void* calloc(std::size_t count, std::size_t size) {
+    AllocProfiler::record(count * size);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, std::size_t size) {
+    void* result = __libc_realloc(ptr, size);
+    if (result != nullptr && result != ptr)
+        AllocProfiler::record(size);
+    return result;
+}
+
+void* memalign(std::size_t alignment, std::size_t size) {
+    AllocProfiler::record(size);
+    return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(std::size_t alignment, std::size_t size) {
+    AllocProfiler::record(size);
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** result, std::size_t alignment, std::size_t size) {
+    if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0)
+        return EINVAL;
+    AllocProfiler::record(size);
+    void* ptr = __libc_memalign(alignment, size);
+    if (ptr == nullptr)
+        return ENOMEM;
+    *result = ptr;
+    return 0;
+}
+
+void* valloc(std::size_t size) {
+    AllocProfiler::record(size);
+    return __libc_valloc(size);
+}
+
+void* pvalloc(std::size_t size) {
+    AllocProfiler::record(size);
+    return __libc_pvalloc(size);
+}
+
+void free(void* ptr) {
+    __libc_free(ptr);
+}
+}
+
+#else
+
+// Elsewhere: replace every form of the global operator new (Qt's malloc-based
+// buffers are not seen)
+namespace {
+
+// Allocate and count a block, nullptr on failure
+void* allocate(std::size_t size) {
+    AllocProfiler::record(size);
+    return std::malloc(size ? size : 1);
+}
+
+// Allocate and count an over-aligned block, nullptr on failure
+void* allocateAligned(std::size_t size, std::align_val_t alignment) {
+    AllocProfiler::record(size);
+    std::size_t align = static_cast<std::size_t>(alignment);
+    std::size_t rounded = (size + align - 1) / align * align;  // aligned_alloc needs a multiple of the alignment
+#if defined(_WIN32)
+    return _aligned_malloc(rounded ? rounded : align, align);
+#else
+    return std::aligned_alloc(align, rounded ? rounded : align);
+#endif
+}
+
+// Release a block from allocateAligned
+void freeAligned(void* ptr) {
+#if defined(_WIN32)
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    if (void* ptr = allocate(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (void* ptr = allocateAligned(size, alignment))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    freeAligned(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+    freeAligned(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+    freeAligned(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+    freeAligned(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    freeAligned(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    freeAligned(ptr);
+}
+
+#endif
+
+#endif // POKER_ALLOC_PROFILE
@@ -0,0 +1,59 @@
+#ifndef ALLOCPROFILER_H
+#define ALLOCPROFILER_H
+
+#include <QString>
+#include <QtGlobal>
+#include <cstddef>
+
+// Heap allocation accounting by engine phase (opt-in build mode).
+// Configure with -DPOKER_ALLOC_PROFILE=ON to hook the global allocator: every
+// allocation is counted, with its size, against the calling thread's current
+// phase, which ALLOC_PHASE sets for the rest of the enclosing scope. Rounds
+// are counted by ALLOC_END_ROUND, so report() gives allocations per round.
+// Without the option the macros compile to nothing and no hook is installed.
+class AllocProfiler {
+public:
+    enum Phase { Other, Deal, Swap, Evaluate, Render, PhaseCount };
+
+    struct Snapshot {
+        quint64 rounds = 0;
+        quint64 allocations[PhaseCount] = {};
+        quint64 bytes[PhaseCount] = {};
+    };
+
+    // Sets the thread's phase until the end of the scope, then restores the previous one
+    class Scope {
+    public:
+        explicit Scope(Phase phase);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        int previous;
+    };
+
+    static constexpr bool enabled();               // Check if the allocator hook is built in
+    static void record(std::size_t bytes);         // Count one allocation in the current phase
+    static void endRound();                        // Count one finished round
+    static Snapshot snapshot();                    // Totals so far
+    static QString report();                       // Allocations and bytes per round, by phase
+};
+
+constexpr bool AllocProfiler::enabled() {
+#ifdef POKER_ALLOC_PROFILE
+    return true;
+#else
+    return false;
+#endif
+}
+
+#ifdef POKER_ALLOC_PROFILE
+#define ALLOC_PHASE(phase) AllocProfiler::Scope allocPhaseScope(AllocProfiler::phase)
+#define ALLOC_END_ROUND() AllocProfiler::endRound()
+#else
+#define ALLOC_PHASE(phase) ((void)0)
+#define ALLOC_END_ROUND() ((void)0)
+#endif
+
+#endif // ALLOCPROFILER_H
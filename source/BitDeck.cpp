@@ -0,0 +1,96 @@
+#include "BitDeck.h"
+#include <QRandomGenerator>
+#include <algorithm>
+
+// Constructor: start with a full deck
+BitDeck::BitDeck() {
+    createDeck();
+}
+
+// Mark all 52 cards (and any jokers, bits 52–53) as live
+void BitDeck::createDeck() {
+    live = FullMask | (((quint64(1) << jokerCount) - 1) << 52);
+}
+
+// Deal a random live card; return default card if empty
+Card BitDeck::dealCard() {
+    int remaining = qPopulationCount(live);
+    if (remaining == 0)
+        return Card(); // Return default card (2 of Clubs) if deck is empty
+
+    int index = selectBit(live, QRandomGenerator::global()->bounded(remaining));
+    live &= ~(quint64(1) << index);
+    return Card::fromIndex(index);
+}
+
+// Get number of undealt cards remaining
+size_t BitDeck::cardsRemaining() const {
+    return qPopulationCount(live);
+}
+
+// Reset the deck to a full set
+void BitDeck::reset() {
+    createDeck();
+}
+
+// Return a dealt card to the deck; its position is irrelevant since deals are random
+bool BitDeck::insertCardRandomly(const Card& card) {
+    int index = card.getIndex();
+    quint64 bit = quint64(1) << index;
+    if (index >= 52 + jokerCount || (live & bit))
+        return false;  // Never part of this deck, or not dealt
+    live |= bit;
+    return true;
+}
+
+// Add 0–2 jokers (black, then red) and rebuild the deck
+void BitDeck::setJokers(int count) {
+    jokerCount = std::clamp(count, 0, 2);
+    createDeck();
+}
+
+// Get number of jokers
+int BitDeck::getJokerCount() const {
+    return jokerCount;
+}
+
+// Check if a card has not been dealt yet
+bool BitDeck::contains(const Card& card) const {
+    return (live >> card.getIndex()) & 1;
+}
+
+// Remove a specific card from the deck
+bool BitDeck::remove(const Card& card) {
+    quint64 bit = quint64(1) << card.getIndex();
+    if (!(live & bit))
+        return false;
+    live &= ~bit;
+    return true;
+}
+
+// Get the mask of live cards
+quint64 BitDeck::liveMask() const {
+    return live;
+}
+
+// Count the live cards in a mask
+int BitDeck::liveCount(quint64 cardMask) const {
+    return qPopulationCount(live & cardMask);
+}
+
+// Find the index of the k-th set bit by halving on popcounts
+int BitDeck::selectBit(quint64 mask, int k) {
+    int base = 0;
+    for (int width = 32; width >= 1; width /= 2) {
+        quint64 low = mask & ((quint64(1) << width) - 1);
+        int count = qPopulationCount(low);
+        if (k >= count) {
+            k -= count;
+            mask >>= width;
+            base += width;
+        } else {
+            mask = low;
+        }
+    }
+    return base;
+}
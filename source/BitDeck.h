@@ -0,0 +1,37 @@
+#ifndef BITDECK_H
+#define BITDECK_H
+
+#include "CardSource.h"
+#include <QtGlobal>
+
+// Deck backed by a 64-bit mask of the 52 cards (bit = Card::getIndex()).
+// Dealing picks a random live bit, so there is no card order to shuffle,
+// and remaining-card queries are single mask operations.
+class BitDeck : public CardSource {
+public:
+    BitDeck();
+
+    void createDeck();                                   // Mark all 52 cards (plus jokers) as live
+    Card dealCard() override;                            // Deal a random live card
+    size_t cardsRemaining() const override;              // Popcount of the live mask
+    void reset() override;                               // Return all cards to the deck
+    bool insertCardRandomly(const Card& card) override;  // Return a dealt card to the deck (false if it is live or not in this deck)
+
+    void setJokers(int count);                           // Add 0–2 jokers and rebuild
+    int getJokerCount() const;                           // Get number of jokers
+
+    bool contains(const Card& card) const;               // Check if a card is still live
+    bool remove(const Card& card);                       // Take a specific card out (false if not live)
+    quint64 liveMask() const override;                   // Get the mask of live cards
+    int liveCount(quint64 cardMask) const override;      // Popcount of the live cards in a mask
+
+    static int selectBit(quint64 mask, int k);           // Index of the k-th set bit (k from 0)
+
+private:
+    static constexpr quint64 FullMask = (quint64(1) << 52) - 1;
+
+    quint64 live;        // Bit i set = Card::fromIndex(i) is still in the deck
+    int jokerCount = 0;  // Jokers in the deck (bits 52–53)
+};
+
+#endif // BITDECK_H
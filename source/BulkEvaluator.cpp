@@ -0,0 +1,250 @@
+#include "BulkEvaluator.h"
+#include "Hand.h"
+#include <QElapsedTimer>
+#include <QFile>
+#include <QtEndian>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+// Category codes as bytes, indexed by rank index; the last entry is "invalid"
+const std::vector<QByteArray>& outputCodes() {
+    static const std::vector<QByteArray> codes = [] {
+        std::vector<QByteArray> list;
+        for (const QString& code : Hand::categoryCodes())
+            list.push_back(code.toLatin1() + '\n');
+        list.push_back("invalid\n");
+        return list;
+    }();
+    return codes;
+}
+
+// Decode one card number the way Hand::setHand does, rejecting impossible cards
+bool decodeCard(int number, Card& card) {
+    int suit = number / 100;
+    int value = number % 100;
+    bool natural = suit >= 1 && suit <= 4 && value >= 2 && value <= 14;
+    bool joker = value == Card::JokerValue && (suit == 1 || suit == 2);
+    if (!natural && !joker)
+        return false;
+    card = Card(value, suit);
+    return true;
+}
+
+// One chunk's output slot in the ordered ring
+struct Slot {
+    QByteArray out;
+    quint64 hands = 0;
+    quint64 invalid = 0;
+    bool ready = false;
+};
+
+} // namespace
+
+// Constructor: worker count and input format
+BulkEvaluator::BulkEvaluator(int threads, int recordCards)
+    : threads(std::max(1, threads)), recordCards(std::max(0, recordCards)) {}
+
+// Cut the input into chunks that end on a line or record boundary
+std::vector<qint64> BulkEvaluator::chunkBounds(const char* data, qint64 size) const {
+    std::vector<qint64> bounds{0};
+    qint64 step = ChunkBytes;
+    if (recordCards > 0) {
+        qint64 record = recordCards * 2;
+        step = std::max(record, ChunkBytes / record * record);
+    }
+
+    qint64 pos = 0;
+    while (pos < size) {
+        qint64 next = std::min(size, pos + step);
+        if (recordCards == 0) {
+            while (next < size && data[next - 1] != '\n')
+                ++next;
+        }
+        bounds.push_back(next);
+        pos = next;
+    }
+    return bounds;
+}
+
+// Score every hand in [begin, end) and append one code line per hand
+void BulkEvaluator::evaluate(const char* begin, const char* end, QByteArray& out,
+                             quint64& hands, quint64& invalid) const {
+    const std::vector<QByteArray>& codes = outputCodes();
+    const QByteArray& invalidCode = codes.back();
+    Hand hand;
+    std::vector<Card> cards;
+    cards.reserve(MaxCards);
+
+    auto score = [&](bool valid) {
+        int rank = valid ? hand.getRankIndex() : -1;
+        const QByteArray& code = rank >= 0 ? codes[rank] : invalidCode;
+        out.append(code);
+        ++hands;
+        if (rank < 0)
+            ++invalid;
+    };
+
+    if (recordCards > 0) {
+        const uchar* p = reinterpret_cast<const uchar*>(begin);
+        const uchar* stop = reinterpret_cast<const uchar*>(end);
+        for (; p + recordCards * 2 <= stop; p += recordCards * 2) {
+            cards.clear();
+            bool valid = recordCards <= MaxCards;
+            for (int i = 0; i < recordCards && valid; ++i) {
+                Card card;
+                valid = decodeCard(qFromLittleEndian<quint16>(p + 2 * i), card);
+                cards.push_back(card);
+            }
+            if (valid)
+                hand.setCards(cards);
+            score(valid);
+        }
+        if (p < stop)
+            score(false);  // Trailing bytes too short for a record (only in the last chunk)
+        return;
+    }
+
+    const char* p = begin;
+    while (p < end) {
+        cards.clear();
+        bool valid = true;
+        int number = -1;
+        for (; p < end && *p != '\n'; ++p) {
+            char c = *p;
+            if (c >= '0' && c <= '9') {
+                if (number > 9999)
+                    valid = false;  // Too long to be a card; stop growing it
+                else
+                    number = (number < 0 ? 0 : number * 10) + (c - '0');
+                continue;
+            }
+            if (c != ' ' && c != '\t' && c != ',' && c != '\r')
+                valid = false;
+            if (number >= 0) {
+                Card card;
+                valid = valid && cards.size() < size_t(MaxCards) && decodeCard(number, card);
+                if (valid)
+                    cards.push_back(card);
+                number = -1;
+            }
+        }
+        if (number >= 0) {
+            Card card;
+            valid = valid && cards.size() < size_t(MaxCards) && decodeCard(number, card);
+            if (valid)
+                cards.push_back(card);
+        }
+        ++p;  // Past the newline
+
+        valid = valid && !cards.empty();
+        if (valid)
+            hand.setCards(cards);
+        score(valid);
+    }
+}
+
+// Score a whole file: workers fill a ring of chunk slots, this thread writes them in order
+BulkEvaluator::Result BulkEvaluator::run(const QString& inputPath, const QString& outputPath) {
+    Result result;
+    QElapsedTimer timer;
+    timer.start();
+
+    QFile input(inputPath);
+    if (!input.open(QIODevice::ReadOnly)) {
+        result.error = "cannot open " + inputPath;
+        return result;
+    }
+    QFile output(outputPath);
+    if (!output.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        result.error = "cannot create " + outputPath;
+        return result;
+    }
+
+    result.bytes = quint64(input.size());
+    const char* data = nullptr;
+    if (input.size() > 0) {
+        data = reinterpret_cast<const char*>(input.map(0, input.size()));
+        if (!data) {
+            result.error = "cannot map " + inputPath;
+            return result;
+        }
+    }
+
+    std::vector<qint64> bounds = chunkBounds(data, input.size());
+    size_t chunks = bounds.size() - 1;
+    size_t window = size_t(threads) * 2;
+    std::vector<Slot> slots(window);
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    size_t written = 0;
+    std::atomic<size_t> nextChunk{0};
+
+    auto work = [&]() {
+        for (size_t i = nextChunk++; i < chunks; i = nextChunk++) {
+            {
+                // Wait until the writer has drained the slot this chunk reuses
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [&] { return i < written + window; });
+            }
+            Slot& slot = slots[i % window];
+            slot.out.resize(0);
+            slot.hands = 0;
+            slot.invalid = 0;
+            evaluate(data + bounds[i], data + bounds[i + 1], slot.out, slot.hands, slot.invalid);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            slot.ready = true;
+            changed.notify_all();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t)
+        pool.emplace_back(work);
+
+    bool writeFailed = false;
+    for (size_t i = 0; i < chunks; ++i) {
+        Slot& slot = slots[i % window];
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [&] { return slot.ready; });
+        }
+        if (!writeFailed && output.write(slot.out) != slot.out.size())
+            writeFailed = true;
+        result.hands += slot.hands;
+        result.invalid += slot.invalid;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        slot.ready = false;
+        ++written;
+        changed.notify_all();
+    }
+    for (auto& thread : pool)
+        thread.join();
+
+    result.seconds = timer.nsecsElapsed() / 1e9;
+    if (writeFailed) {
+        result.error = "cannot write " + outputPath;
+        return result;
+    }
+    result.ok = true;
+    return result;
+}
+
+// Format a run as one report line
+QString BulkEvaluator::format(const Result& result) {
+    if (!result.ok)
+        return "HandEval: " + result.error;
+    double seconds = std::max(result.seconds, 1e-9);
+    return QString("%1 hands (%2 invalid) in %3 s: %4 hands/s, %5 MB/s")
+        .arg(result.hands)
+        .arg(result.invalid)
+        .arg(result.seconds, 0, 'f', 2)
+        .arg(result.hands / seconds, 0, 'f', 0)
+        .arg(result.bytes / seconds / 1e6, 0, 'f', 1);
+}
@@ -0,0 +1,48 @@
+#ifndef BULKEVALUATOR_H
+#define BULKEVALUATOR_H
+
+#include <QByteArray>
+#include <QString>
+#include <QtGlobal>
+#include <vector>
+
+// Streaming evaluator for large hand files.
+// The input is memory-mapped and cut into chunks at record boundaries. Worker
+// threads parse and score chunks straight from the mapping (Hand::setCards,
+// then the category of Hand::getBest) and the results are written in input
+// order, one category code per line. At most two chunk results per thread
+// are held at once, so memory stays flat whatever the input size.
+//
+// Text input: one hand per line, card numbers as in Card::getNumber()
+// separated by spaces, tabs or commas (e.g. "412 312 214 209 102").
+// Binary input: fixed records of recordCards little-endian 16-bit card numbers.
+// Lines or records that are not 5–7 valid cards score "invalid", and so do
+// trailing bytes of a binary file that do not fill a whole record.
+class BulkEvaluator {
+public:
+    struct Result {
+        bool ok = false;
+        QString error;           // Why the run failed
+        quint64 hands = 0;       // Lines or records scored
+        quint64 invalid = 0;     // Of which malformed
+        quint64 bytes = 0;       // Input size
+        double seconds = 0;
+    };
+
+    BulkEvaluator(int threads, int recordCards = 0);   // recordCards 0 = text input
+
+    Result run(const QString& inputPath, const QString& outputPath); // Score a whole file
+    static QString format(const Result& result);        // One report line
+
+private:
+    static constexpr qint64 ChunkBytes = 4 << 20;
+    static constexpr int MaxCards = 7;
+
+    int threads;
+    int recordCards;
+
+    std::vector<qint64> chunkBounds(const char* data, qint64 size) const; // Chunk start offsets plus the end
+    void evaluate(const char* begin, const char* end, QByteArray& out, quint64& hands, quint64& invalid) const;
+};
+
+#endif // BULKEVALUATOR_H
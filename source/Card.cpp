@@ -11,8 +11,14 @@ int Card::getValue() const {
     return value;
 }
 
+// Check if the card is a joker
+bool Card::isJoker() const {
+    return value == JokerValue;
+}
+
 // Get suit as a string
 QString Card::getSuit() const {
+    if (isJoker()) return "Joker";
     switch (suit) {
     case 1: return "Clubs";
     case 2: return "Diamonds";
@@ -24,6 +30,8 @@ QString Card::getSuit() const {
 
 // Get full card name, e.g., "King of Spades"
 QString Card::getName() const {
+    if (isJoker()) return suit == 2 ? "Red Joker" : "Black Joker";
+
     QString valueStr;
     switch (value) {
     case 11: valueStr = "Jack"; break;
@@ -43,6 +51,9 @@ int Card::getNumber() const {
 
 // Get image file path, e.g., "images/king_of_spades.png"
 QString Card::getImagePath() const {
+    if (isJoker())
+        return suit == 2 ? ":/cards/images/red_joker.png" : ":/cards/images/black_joker.png";
+
     QString valueStr;
     switch (value) {
     case 11: valueStr = "jack"; break;
@@ -58,3 +69,15 @@ QString Card::getImagePath() const {
     // Full path becomes ":/images/cards/queen_of_clubs.png"
     return QString(":/cards/images/%1_of_%2.png").arg(valueStr, suitStr);
 }
+
+// Get bit index (0–53), matching the order of Deck::createDeck
+int Card::getIndex() const {
+    if (isJoker()) return 52 + (suit - 1);
+    return (value - 2) * 4 + (suit - 1);
+}
+
+// Build a card from a bit index (0–53)
+Card Card::fromIndex(int index) {
+    if (index >= 52) return Card(JokerValue, index - 51);
+    return Card(index / 4 + 2, index % 4 + 1);
+}
@@ -6,13 +6,18 @@
 class Card {
 public:
     Card();
-    Card(int value, int suit);  // suit: 1=Clubs, 2=Diamonds, 3=Hearts, 4=Spades
+    Card(int value, int suit);  // suit: 1=Clubs, 2=Diamonds, 3=Hearts, 4=Spades (value 15: 1=Black, 2=Red joker)
 
-    int getValue() const;            // Returns value: 2–14 (J=11, Q=12, K=13, A=14)
+    int getValue() const;            // Returns value: 2–14 (J=11, Q=12, K=13, A=14), 15 for a joker
+    bool isJoker() const;            // Returns true for a black or red joker
     QString getSuit() const;         // Returns suit as string, e.g., "Hearts"
     QString getName() const;         // Returns card name, e.g., "King of Spades"
     int getNumber() const;           // Returns encoded number, e.g., 209 = 9 of Diamonds
     QString getImagePath() const;    // Returns image file path
+    int getIndex() const;            // Returns bit index 0–53, e.g., 0 = 2 of Clubs, 51 = Ace of Spades, 52/53 = jokers
+
+    static Card fromIndex(int index);  // Build a card from its bit index
+    static constexpr int JokerValue = 15;
 
 private:
     int value; // Card value: 2–14
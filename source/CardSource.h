@@ -0,0 +1,23 @@
+#ifndef CARDSOURCE_H
+#define CARDSOURCE_H
+
+#include "Card.h"
+#include <QtGlobal>
+#include <cstddef>
+
+// What a hand needs from a deck: deal, return, and count what is left.
+// Deck (shuffled vector, shoes, jokers) and BitDeck (52-bit mask) implement it
+// independently, so neither carries the other's state.
+class CardSource {
+public:
+    virtual ~CardSource() = default;
+
+    virtual void reset() = 0;                                // Return every card and start over
+    virtual Card dealCard() = 0;                             // Deal one card (default card if empty)
+    virtual size_t cardsRemaining() const = 0;               // Get the number of undealt cards
+    virtual bool insertCardRandomly(const Card& card) = 0;   // Return a dealt card to a random undealt position (false if no copy of it is out)
+    virtual quint64 liveMask() const = 0;                    // Get the mask of cards with a live copy (bit = Card::getIndex())
+    virtual int liveCount(quint64 cardMask) const = 0;       // Count the live copies of the cards in a mask
+};
+
+#endif // CARDSOURCE_H
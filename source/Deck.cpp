@@ -1,5 +1,6 @@
 #include "Deck.h"
 #include <QRandomGenerator>
+#include <QtAlgorithms>
 
 // Constructor: initialize and shuffle a full deck
 Deck::Deck() {
@@ -7,15 +8,28 @@ Deck::Deck() {
     shuffle();
 }
 
-// Create a full 52-card deck (values 2–14, suits 1–4)
+// Create a full deck (values 2–14, suits 1–4, plus any jokers) for each deck in the shoe.
+// Cards are written in place, so after the first call no memory is allocated.
 void Deck::createDeck() {
-    cards.clear();
-    for (int value = 2; value <= 14; ++value) {
-        for (int suit = 1; suit <= 4; ++suit) {
-            cards.emplace_back(value, suit);
+    cards.resize(deckCount * (52 + jokerCount));
+    int i = 0;
+    for (int d = 0; d < deckCount; ++d) {
+        for (int value = 2; value <= 14; ++value) {
+            for (int suit = 1; suit <= 4; ++suit) {
+                cards[i++] = Card(value, suit);
+            }
+        }
+        for (int j = 1; j <= jokerCount; ++j) {
+            cards[i++] = Card(Card::JokerValue, j);
         }
     }
     currentIndex = 0;
+
+    std::fill(liveCopies, liveCopies + 52, quint8(deckCount));
+    std::fill(liveCopies + 52, liveCopies + 54, quint8(0));
+    for (int j = 1; j <= jokerCount; ++j)
+        liveCopies[51 + j] = quint8(deckCount);
+    live = ((quint64(1) << 52) - 1) | (((quint64(1) << jokerCount) - 1) << 52);
 }
 
 // Shuffle the deck and reset the current index
@@ -28,10 +42,12 @@ void Deck::shuffle() {
 
 // Deal one card from the deck; return default card if empty
 Card Deck::dealCard() {
-    if (currentIndex < static_cast<int>(cards.size()))
+    if (currentIndex < static_cast<int>(cards.size())) {
+        markDealt(cards[currentIndex]);
         return cards[currentIndex++];
-    else
+    } else {
         return Card(); // Return default card (2 of Clubs) if deck is empty
+    }
 }
 
 // Get number of undealt cards remaining
@@ -45,14 +61,108 @@ void Deck::reset() {
     shuffle();
 }
 
-// Insert a card at a random position after currentIndex
-void Deck::insertCardRandomly(const Card& card) {
-    if (cards.empty()) {
-        cards.push_back(card);
-        return;
-    }
+// Return a dealt card to a random position after currentIndex.
+// The card takes over the slot just before currentIndex (already dealt) and is
+// then swapped with a random undealt slot, so the deck never grows. Only a card
+// with a copy out of this deck is taken back: one that was never part of it,
+// was already returned, or was dealt before the last reset is refused, and so
+// is every card while nothing is dealt (currentIndex == 0).
+bool Deck::insertCardRandomly(const Card& card) {
+    int index = card.getIndex();
+    if (liveCopies[index] >= copiesOf(index))
+        return false;
+    Q_ASSERT(currentIndex > 0);  // A copy is out, so something was dealt
+
+    markReturned(card);
+    --currentIndex;
+    int pos = QRandomGenerator::global()->bounded(currentIndex, static_cast<int>(cards.size()));
+    cards[currentIndex] = cards[pos];
+    cards[pos] = card;
+    return true;
+}
+
+// Get the mask of cards that still have an undealt copy
+quint64 Deck::liveMask() const {
+    return live;
+}
+
+// Count the undealt copies of the cards in a mask (a popcount for a single deck)
+int Deck::liveCount(quint64 cardMask) const {
+    quint64 mask = cardMask & live;
+    if (deckCount == 1)
+        return qPopulationCount(mask);
+
+    int count = 0;
+    for (; mask != 0; mask &= mask - 1)
+        count += liveCopies[qCountTrailingZeroBits(mask)];
+    return count;
+}
+
+// Take one copy of a card out of the live counts
+void Deck::markDealt(const Card& card) {
+    int index = card.getIndex();
+    if (liveCopies[index] > 0 && --liveCopies[index] == 0)
+        live &= ~(quint64(1) << index);
+}
+
+// Put one copy of a card back into the live counts
+void Deck::markReturned(const Card& card) {
+    int index = card.getIndex();
+    ++liveCopies[index];
+    live |= quint64(1) << index;
+}
+
+// Get the copies of a card the full shoe holds (jokers only up to the joker count)
+int Deck::copiesOf(int index) const {
+    return index < 52 || index - 52 < jokerCount ? deckCount : 0;
+}
+
+// Switch to a shoe of 1–8 decks with a cut card at the given penetration (0.1–1.0)
+void Deck::setShoe(int decks, double penetration) {
+    deckCount = std::clamp(decks, 1, 8);
+    cutFraction = std::clamp(penetration, 0.1, 1.0);
+    shoe = true;
+    resizeShoe();
+}
+
+// Go back to a single deck dealt to the end
+void Deck::setSingleDeck() {
+    deckCount = 1;
+    cutFraction = 1.0;
+    shoe = false;
+    resizeShoe();
+}
+
+// Reserve room for the whole shoe once (so reshuffles never reallocate), place the cut card and rebuild
+void Deck::resizeShoe() {
+    size_t total = deckCount * (52 + jokerCount);
+    cards.reserve(total);
+    cutIndex = static_cast<size_t>(total * cutFraction);
+    reset();
+}
+
+// Check if shoe mode is on
+bool Deck::isShoe() const {
+    return shoe;
+}
+
+// Get number of decks in the shoe
+int Deck::getDeckCount() const {
+    return deckCount;
+}
+
+// Add 0–2 jokers (black, then red) to each deck and rebuild it
+void Deck::setJokers(int count) {
+    jokerCount = std::clamp(count, 0, 2);
+    resizeShoe();
+}
+
+// Get number of jokers per deck
+int Deck::getJokerCount() const {
+    return jokerCount;
+}
 
-    // Insert between currentIndex and end (to avoid duplicates in dealt cards)
-    int pos = QRandomGenerator::global()->bounded(currentIndex, static_cast<int>(cards.size()) + 1);
-    cards.insert(cards.begin() + pos, card);
+// Check if the cut card has been reached (or too few cards are left for a round)
+bool Deck::needsReshuffle(size_t cardsPerRound) const {
+    return static_cast<size_t>(currentIndex) >= cutIndex || cardsRemaining() < cardsPerRound;
 }
@@ -2,25 +2,49 @@
 #define DECK_H
 
 #include "Card.h"
+#include "CardSource.h"
+#include <QtGlobal>
 #include <vector>
 #include <random>
 #include <algorithm>
 
-class Deck {
+class Deck : public CardSource {
 public:
     Deck();
 
-    void createDeck();                           // Initialize a standard 52-card deck
-    void shuffle();                              // Shuffle the deck randomly
-    Card dealCard();                             // Deal one card from the top
-    size_t cardsRemaining() const;               // Get the number of undealt cards
-    void reset();                                // Reset and reshuffle the deck
-    void insertCardRandomly(const Card& card);   // Insert a card at a random position
+    void createDeck();                                   // Initialize a standard 52-card deck
+    void shuffle();                                      // Shuffle the deck randomly
+    Card dealCard() override;                            // Deal one card from the top
+    size_t cardsRemaining() const override;              // Get the number of undealt cards
+    void reset() override;                               // Reset and reshuffle the deck
+    bool insertCardRandomly(const Card& card) override;  // Put a dealt card back at a random undealt position (false if none is out)
+    quint64 liveMask() const override;                   // Get the mask of cards with a live copy (bit = Card::getIndex())
+    int liveCount(quint64 cardMask) const override;      // Count the live copies of the cards in a mask
+
+    void setShoe(int decks, double penetration);         // Use 1–8 decks, reshuffle after dealing this fraction
+    void setSingleDeck();                                // Leave shoe mode: one deck, dealt to the end
+    bool isShoe() const;                                 // Check if shoe mode is on
+    int getDeckCount() const;                            // Get number of decks in the shoe
+    bool needsReshuffle(size_t cardsPerRound) const;     // Check if the cut card has been reached or a round no longer fits
+    void setJokers(int count);                           // Add 0–2 jokers to each deck
+    int getJokerCount() const;                           // Get number of jokers per deck
 
 private:
     std::vector<Card> cards;     // Active deck
     std::vector<Card> discard;   // Discarded cards (optional use)
     int currentIndex;            // Index of the next card to deal
+    int deckCount = 1;           // Number of 52-card decks
+    bool shoe = false;           // Reshuffle at the cut card instead of running out
+    int jokerCount = 0;          // Jokers added to each deck
+    double cutFraction = 1.0;    // Penetration: fraction of the shoe dealt before reshuffling
+    size_t cutIndex = 52;        // Position of the cut card
+    quint64 live = 0;            // Bit i set = at least one copy of Card::fromIndex(i) is undealt
+    quint8 liveCopies[54] = {};  // Undealt copies of each card, by Card::getIndex()
+
+    void resizeShoe();           // Apply deck/joker counts and rebuild
+    void markDealt(const Card& card);    // Take one copy out of the live counts
+    void markReturned(const Card& card); // Put one copy back into the live counts
+    int copiesOf(int index) const;       // Copies of Card::fromIndex(index) in the full shoe
 };
 
 #endif // DECK_H
@@ -0,0 +1,160 @@
+#include "DeckBenchmark.h"
+#include "BitDeck.h"
+#include "Deck.h"
+#include "Hand.h"
+#include <QElapsedTimer>
+#include <cmath>
+#include <thread>
+
+namespace {
+
+constexpr int DeckSize = 52;
+constexpr int HandSize = 5;
+constexpr int Returned = 3;
+constexpr int AfterSwap = DeckSize - HandSize;  // Cards left once the swapped cards are back
+
+// Run work(threadCounts) on every thread and sum the per-thread counters
+template <typename Work>
+std::vector<quint64> runThreads(int threads, size_t cells, Work work) {
+    std::vector<std::vector<quint64>> local(threads, std::vector<quint64>(cells, 0));
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t)
+        pool.emplace_back([&work, &local, t]() { work(local[t]); });
+    for (auto& thread : pool)
+        thread.join();
+
+    std::vector<quint64> total(cells, 0);
+    for (const auto& counts : local) {
+        for (size_t i = 0; i < cells; ++i)
+            total[i] += counts[i];
+    }
+    return total;
+}
+
+// reset() the deck, then record the position every card is dealt at
+template <typename DeckType>
+void shuffleTrials(quint64 trials, std::vector<quint64>& counts) {
+    DeckType deck;
+    for (quint64 n = 0; n < trials; ++n) {
+        deck.reset();
+        for (int pos = 0; pos < DeckSize; ++pos)
+            counts[deck.dealCard().getIndex() * DeckSize + pos]++;
+    }
+}
+
+// Deal a hand, swap three cards back into the deck, and record where they come out
+template <typename DeckType>
+void returnTrials(quint64 trials, std::vector<quint64>& counts) {
+    DeckType deck;
+    Hand hand;
+    for (quint64 n = 0; n < trials; ++n) {
+        deck.reset();
+        hand.dealHand(deck);
+        int returned[Returned];
+        for (int i = 0; i < Returned; ++i)
+            returned[i] = hand.getCards()[i].getIndex();
+        hand.swapCard({0, 1, 2}, deck);
+
+        for (int pos = 0; pos < AfterSwap; ++pos) {
+            int index = deck.dealCard().getIndex();
+            for (int r : returned) {
+                if (index == r)
+                    counts[pos]++;
+            }
+        }
+    }
+}
+
+// Upper tail of the chi-square distribution (Wilson-Hilferty normal approximation)
+double chiSquarePValue(double chiSquare, int dof) {
+    double k = dof;
+    double z = (std::cbrt(chiSquare / k) - (1.0 - 2.0 / (9.0 * k))) / std::sqrt(2.0 / (9.0 * k));
+    return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+} // namespace
+
+// Constructor: workload size
+DeckBenchmark::DeckBenchmark(int threads, quint64 trialsPerThread)
+    : threads(std::max(1, threads)), trials(trialsPerThread) {}
+
+// Shuffle benchmark: every reset() must put each card in each position with probability 1/52
+DeckBenchmark::Result DeckBenchmark::runShuffle(bool bitDeck) {
+    Result result;
+    result.name = bitDeck ? "shuffle/BitDeck" : "shuffle/Deck";
+
+    QElapsedTimer timer;
+    timer.start();
+    quint64 perThread = trials;
+    auto counts = runThreads(threads, DeckSize * DeckSize, [bitDeck, perThread](std::vector<quint64>& local) {
+        if (bitDeck)
+            shuffleTrials<BitDeck>(perThread, local);
+        else
+            shuffleTrials<Deck>(perThread, local);
+    });
+    result.seconds = timer.nsecsElapsed() / 1e9;
+    result.ops = quint64(threads) * trials;
+
+    // Each trial adds a whole permutation matrix, so the Pearson sum is n/(n-1)
+    // times a chi-square with (n-1)^2 degrees of freedom; scale it back by (n-1)/n
+    finish(result, counts, double(result.ops) / DeckSize, 1.0 / DeckSize, (DeckSize - 1) * (DeckSize - 1),
+           double(DeckSize - 1) / DeckSize);
+    return result;
+}
+
+// Return benchmark: returned cards must be equally likely at every position of the remaining deck
+DeckBenchmark::Result DeckBenchmark::runReturn(bool bitDeck) {
+    Result result;
+    result.name = bitDeck ? "return/BitDeck" : "return/Deck";
+
+    QElapsedTimer timer;
+    timer.start();
+    quint64 perThread = trials;
+    auto counts = runThreads(threads, AfterSwap, [bitDeck, perThread](std::vector<quint64>& local) {
+        if (bitDeck)
+            returnTrials<BitDeck>(perThread, local);
+        else
+            returnTrials<Deck>(perThread, local);
+    });
+    result.seconds = timer.nsecsElapsed() / 1e9;
+    result.ops = quint64(threads) * trials * Returned;
+
+    // Each trial puts the returned cards in distinct positions, so a cell is hit with
+    // p = 3/47 and the Pearson sum is (1-p)m/(m-1) times a chi-square with m-1
+    // degrees of freedom (m = 47 positions); scale it back by the inverse
+    double hitProbability = double(Returned) / AfterSwap;
+    finish(result, counts, double(result.ops) / AfterSwap, hitProbability, AfterSwap - 1,
+           double(AfterSwap - 1) / (AfterSwap * (1.0 - hitProbability)));
+    return result;
+}
+
+// Compute chi-square (scaled to dof degrees of freedom), p-value and the worst single-cell deviation
+void DeckBenchmark::finish(Result& result, const std::vector<quint64>& counts,
+                           double expected, double cellProbability, int dof, double scale) {
+    double sigma = std::sqrt(expected * (1.0 - cellProbability));
+
+    result.chiSquare = 0;
+    result.maxDeviation = 0;
+    for (quint64 observed : counts) {
+        double diff = double(observed) - expected;
+        result.chiSquare += diff * diff / expected;
+        if (sigma > 0)
+            result.maxDeviation = std::max(result.maxDeviation, std::abs(diff) / sigma);
+    }
+    result.chiSquare *= scale;
+    result.dof = dof;
+    result.pValue = chiSquarePValue(result.chiSquare, dof);
+}
+
+// Format one result as a report line
+QString DeckBenchmark::format(const Result& result) {
+    return QString("%1: %2 ops in %3 s = %4 ops/s | chi2 %5 (dof %6, p = %7) | max cell deviation %8 sigma")
+        .arg(result.name)
+        .arg(result.ops)
+        .arg(result.seconds, 0, 'f', 2)
+        .arg(result.ops / std::max(result.seconds, 1e-9), 0, 'f', 0)
+        .arg(result.chiSquare, 0, 'f', 1)
+        .arg(result.dof)
+        .arg(result.pValue, 0, 'f', 4)
+        .arg(result.maxDeviation, 0, 'f', 2);
+}
@@ -0,0 +1,39 @@
+#ifndef DECKBENCHMARK_H
+#define DECKBENCHMARK_H
+
+#include <QString>
+#include <QtGlobal>
+#include <vector>
+
+// Throughput and uniformity benchmark for deck shuffling and card returns.
+// Every workload runs on several threads, each with its own deck and counters,
+// and reports ops/sec together with a chi-square test of the observed
+// card/position counts against a uniform distribution.
+class DeckBenchmark {
+public:
+    struct Result {
+        QString name;            // Workload and deck type
+        quint64 ops = 0;         // Shuffles or card returns performed
+        double seconds = 0;
+        double chiSquare = 0;
+        int dof = 0;             // Degrees of freedom of the chi-square test
+        double pValue = 0;       // Probability of a chi-square at least this large if uniform
+        double maxDeviation = 0; // Largest |observed - expected| of one cell, in standard deviations
+    };
+
+    DeckBenchmark(int threads, quint64 trialsPerThread);
+
+    Result runShuffle(bool bitDeck);   // reset() then deal out: card x position matrix
+    Result runReturn(bool bitDeck);    // Deal a hand, swap 3, deal out: where returned cards land
+
+    static QString format(const Result& result);   // One report line
+
+private:
+    int threads;
+    quint64 trials;
+
+    static void finish(Result& result, const std::vector<quint64>& counts,
+                       double expected, double cellProbability, int dof, double scale);
+};
+
+#endif // DECKBENCHMARK_H
@@ -1,12 +1,17 @@
 #include "Game.h"
+#include "Statistics.h"
+#include "AllocProfiler.h"
 #include <QStringList>
-#include <QMap>
+#include <QtAlgorithms>
 
 // Constructor: initialize players, round counter, and state
-Game::Game() : player("You"), computer("Computer"), round(0), lastRoundWinner(nullptr) {}
+template <typename Rules>
+BasicGame<Rules>::BasicGame() : player("You"), computer("Computer"), round(0), lastRoundWinner(nullptr) {}
 
 // Start a new game session
-void Game::startGame() {
+template <typename Rules>
+void BasicGame<Rules>::startGame() {
+    closeRound();
     player.resetScore();
     computer.resetScore();
     deck.reset();
@@ -15,73 +20,72 @@ void Game::startGame() {
 }
 
 // Deal cards for the next round and determine the winner
-bool Game::dealNextRound() {
-    if (deck.cardsRemaining() < 10)
+template <typename Rules>
+bool BasicGame<Rules>::dealNextRound() {
+    if (!dealCards())
         return false;
 
-    player.getHand().dealHand(deck);
-    computer.getHand().dealHand(deck);
-    ++round;
+    // Evaluate round result
+    scoreRound();
 
-    isDraw = false;
-    hasSwappedThisRound = false;
+    return true;
+}
 
-    // Evaluate round result
-    int pRank = player.getHand().getRankIndex();
-    int cRank = computer.getHand().getRankIndex();
+// Deal the next round's hands without scoring them (call scoreRound afterwards)
+template <typename Rules>
+bool BasicGame<Rules>::dealCards() {
+    closeRound();
+    ALLOC_PHASE(Deal);
 
-    if (pRank < cRank) {
-        player.incrementScore();
-        lastRoundWinner = &player;
-    } else if (pRank > cRank) {
-        computer.incrementScore();
-        lastRoundWinner = &computer;
-    } else {
-        int pPrimary = player.getHand().getPrimaryValue();
-        int cPrimary = computer.getHand().getPrimaryValue();
-
-        if (pPrimary > cPrimary) {
-            player.incrementScore();
-            lastRoundWinner = &player;
-        } else if (cPrimary > pPrimary) {
-            computer.incrementScore();
-            lastRoundWinner = &computer;
-        } else {
-            auto pSec = player.getHand().getSecondaryValues();
-            auto cSec = computer.getHand().getSecondaryValues();
-
-            bool determined = false;
-            for (int i = 0; i < std::min(pSec.size(), cSec.size()); ++i) {
-                if (pSec[i] > cSec[i]) {
-                    player.incrementScore();
-                    lastRoundWinner = &player;
-                    determined = true;
-                    break;
-                } else if (pSec[i] < cSec[i]) {
-                    computer.incrementScore();
-                    lastRoundWinner = &computer;
-                    determined = true;
-                    break;
-                }
-            }
-
-            if (!determined) {
-                isDraw = true;
-                lastRoundWinner = nullptr;
-            }
+    // A shoe is reshuffled in place at the cut card instead of ending the game
+    const size_t cardsPerRound = holdem ? HoldemCards : DrawCards;
+    if (deck.isShoe() && deck.needsReshuffle(cardsPerRound))
+        deck.reset();
+
+    if (deck.cardsRemaining() < cardsPerRound)
+        return false;
+
+    if (holdem) {
+        // Hole cards alternate between the seats, then the board is dealt;
+        // each hand holds its two hole cards followed by the five board cards
+        std::vector<Card> playerCards, computerCards;
+        for (int i = 0; i < 2; ++i) {
+            playerCards.push_back(deck.dealCard());
+            computerCards.push_back(deck.dealCard());
         }
+        board.clear();
+        for (int i = 0; i < 5; ++i)
+            board.push_back(deck.dealCard());
+
+        playerCards.insert(playerCards.end(), board.begin(), board.end());
+        computerCards.insert(computerCards.end(), board.begin(), board.end());
+        player.getHand().setCards(playerCards);
+        computer.getHand().setCards(computerCards);
+    } else {
+        player.getHand().dealHand(deck, Rules::HandSize);
+        computer.getHand().dealHand(deck, Rules::HandSize);
     }
+    ++round;
+
+    isDraw = false;
+    hasSwappedThisRound = false;
+    roundRecorded = false;
+    lastRoundWinner = nullptr;
+    computerSwap = -1;
+    playerSwap = 0;
 
     return true;
 }
 
 // Get winner of the last round
-const Player* Game::winnerOfRound() const {
+template <typename Rules>
+const Player* BasicGame<Rules>::winnerOfRound() const {
     return lastRoundWinner;
 }
 
 // Get overall winner (by score)
-Player const& Game::overallWinner() const {
+template <typename Rules>
+Player const& BasicGame<Rules>::overallWinner() const {
     if (player.getScore() > computer.getScore())
         return player;
     else if (computer.getScore() > player.getScore())
@@ -91,202 +95,210 @@ Player const& Game::overallWinner() const {
 }
 
 // Get current round number
-int Game::currentRound() const {
+template <typename Rules>
+int BasicGame<Rules>::currentRound() const {
     return round;
 }
 
 // Get player object
-Player& Game::getPlayer() {
+template <typename Rules>
+Player& BasicGame<Rules>::getPlayer() {
     return player;
 }
 
 // Get computer object
-Player& Game::getComputer() {
+template <typename Rules>
+Player& BasicGame<Rules>::getComputer() {
     return computer;
 }
 
 // Get deck object
-Deck& Game::getDeck() {
+template <typename Rules>
+Deck& BasicGame<Rules>::getDeck() {
     return deck;
 }
 
 // Check if last round was a draw
-bool Game::wasDraw() const {
+template <typename Rules>
+bool BasicGame<Rules>::wasDraw() const {
     return isDraw;
 }
 
-// Player swaps up to 3 cards (only once per round in first 4 rounds)
-void Game::playerSwapCards(const QVector<int>& indices) {
-    if (round < 5 && !hasSwappedThisRound && indices.size() <= 3) {
-        player.getHand().swapCard(indices, deck);
-        hasSwappedThisRound = true;
+// Player swaps up to SwapLimit cards (only once per round in the first SwapRounds rounds, never in Hold'em)
+template <typename Rules>
+bool BasicGame<Rules>::playerSwapCards(const QVector<int>& indices) {
+    if (!swapCards(indices))
+        return false;
 
-        computerSwapOneCardIfNeeded();
-        evaluateHands();
-    }
+    evaluateHands();
+
+    // Nothing else can change this round once the swap is done
+    closeRound();
+    return true;
+}
+
+// Apply the player's swap and the computer's reply without re-scoring (false if not allowed)
+template <typename Rules>
+bool BasicGame<Rules>::swapCards(const QVector<int>& indices) {
+    if (holdem || round > Rules::SwapRounds || hasSwappedThisRound || indices.size() > Rules::SwapLimit)
+        return false;
+    ALLOC_PHASE(Swap);
+
+    Hand before = player.getHand();
+    playerSwap = quint8(player.getHand().swapCard(indices, deck));
+    hasSwappedThisRound = true;
+    Statistics::instance().recordSwap(0, compareHands(player.getHand(), before) > 0);
+
+    computerSwapOneCardIfNeeded(int(qPopulationCount(playerSwap)));
+    return true;
 }
 
 // Re-evaluate both hands and update scores (after swap)
-void Game::evaluateHands() {
+template <typename Rules>
+void BasicGame<Rules>::evaluateHands() {
+    ALLOC_PHASE(Evaluate);
+    evaluateHands(compareHands(player.getHand(), computer.getHand()));
+}
+
+// Take back the previous winner's point and award it for the given comparison
+template <typename Rules>
+void BasicGame<Rules>::evaluateHands(int result) {
     if (lastRoundWinner == &player)
         player.incrementScore(-1);
     else if (lastRoundWinner == &computer)
         computer.incrementScore(-1);
 
-    int pRank = player.getHand().getRankIndex();
-    int cRank = computer.getHand().getRankIndex();
-    isDraw = false;
+    scoreRound(result);
+}
 
-    if (pRank < cRank) {
-        player.incrementScore();
-        lastRoundWinner = &player;
-    } else if (pRank > cRank) {
-        computer.incrementScore();
-        lastRoundWinner = &computer;
-    } else {
-        int pPrimary = player.getHand().getPrimaryValue();
-        int cPrimary = computer.getHand().getPrimaryValue();
-
-        if (pPrimary > cPrimary) {
-            player.incrementScore();
-            lastRoundWinner = &player;
-        } else if (cPrimary > pPrimary) {
-            computer.incrementScore();
-            lastRoundWinner = &computer;
-        } else {
-            auto pSec = player.getHand().getSecondaryValues();
-            auto cSec = computer.getHand().getSecondaryValues();
-
-            bool determined = false;
-            for (int i = 0; i < std::min(pSec.size(), cSec.size()); ++i) {
-                if (pSec[i] > cSec[i]) {
-                    player.incrementScore();
-                    lastRoundWinner = &player;
-                    determined = true;
-                    break;
-                } else if (pSec[i] < cSec[i]) {
-                    computer.incrementScore();
-                    lastRoundWinner = &computer;
-                    determined = true;
-                    break;
-                }
-            }
-
-            if (!determined) {
-                isDraw = true;
-                lastRoundWinner = nullptr;
-            }
-        }
-    }
+// Switch between five-card draw and Hold'em (takes effect on the next deal)
+template <typename Rules>
+void BasicGame<Rules>::setHoldem(bool enabled) {
+    holdem = enabled;
+    board.clear();
 }
 
-// Enhanced computer swap logic with strategy to form flush, straight, full house, or four of a kind
-void Game::computerSwapOneCardIfNeeded() {
-    QString type = computer.getHand().getBest();
-    const auto& cards = computer.getHand().getCards();
-    int keyVal = computer.getHand().getPrimaryValue();
-    int swapIndex = -1;
+// Check if Hold'em mode is on
+template <typename Rules>
+bool BasicGame<Rules>::isHoldem() const {
+    return holdem;
+}
 
-    QMap<int, int> valCount;
-    QMap<QString, int> suitCount;
-    QVector<int> values;
+// Load a strategy table written by SwapSolver for the computer seat
+template <typename Rules>
+bool BasicGame<Rules>::loadComputerStrategy(const QString& path) {
+    return computerStrategy.load(path);
+}
 
-    for (const auto& c : cards) {
-        valCount[c.getValue()]++;
-        suitCount[c.getSuit()]++;
-        values.push_back(c.getValue());
-    }
+// Get the outs of the player's or the computer's current hand, scoring them only when asked
+template <typename Rules>
+const HandOuts& BasicGame<Rules>::outsOf(const Player& seat) {
+    bool isComputer = &seat == &computer;
+    HandOuts& outs = isComputer ? computerOuts : playerOuts;
+    outs.update(isComputer ? computer.getHand() : player.getHand(), deck);
+    return outs;
+}
 
-    // Try to form a flush if one suit has 4 cards
-    for (const auto& suit : suitCount.keys()) {
-        if (suitCount[suit] == 4) {
-            for (int i = 0; i < cards.size(); ++i) {
-                if (cards[i].getSuit() != suit) {
-                    swapIndex = i;
-                    break;
-                }
-            }
-            break;
-        }
-    }
+// Get the card index the computer swapped this round (-1 if none)
+template <typename Rules>
+int BasicGame<Rules>::lastComputerSwap() const {
+    return computerSwap;
+}
 
-    // Try to form a straight if we already have 4 close consecutive values
-    if (swapIndex == -1) {
-        std::sort(values.begin(), values.end());
-        int consecutive = 1;
-        for (int i = 1; i < values.size(); ++i) {
-            if (values[i] == values[i - 1] + 1) {
-                consecutive++;
-            } else if (values[i] != values[i - 1]) {
-                consecutive = 1;
-            }
-            if (consecutive >= 4) {
-                for (int j = 0; j < cards.size(); ++j) {
-                    bool partOfStraight = false;
-                    for (int k = 0; k < values.size(); ++k) {
-                        if (std::abs(cards[j].getValue() - values[k]) <= 1) {
-                            partOfStraight = true;
-                            break;
-                        }
-                    }
-                    if (!partOfStraight) {
-                        swapIndex = j;
-                        break;
-                    }
-                }
-                break;
-            }
-        }
-    }
+// Get the cards the player's swap replaced this round
+template <typename Rules>
+quint8 BasicGame<Rules>::lastPlayerSwap() const {
+    return playerSwap;
+}
 
-    // Try to form a full house if we already have a trio
-    if (swapIndex == -1 && type == "trio") {
-        for (int i = 0; i < cards.size(); ++i) {
-            int v = cards[i].getValue();
-            if (valCount[v] != 3 && valCount[v] != 2) {
-                swapIndex = i;
-                break;
-            }
-        }
-    }
+// Get the community cards of the current Hold'em round
+template <typename Rules>
+const std::vector<Card>& BasicGame<Rules>::getBoard() const {
+    return board;
+}
 
-    // Try to form four of a kind from a trio
-    if (swapIndex == -1 && type == "trio") {
-        for (int i = 0; i < cards.size(); ++i) {
-            if (cards[i].getValue() != keyVal) {
-                swapIndex = i;
-                break;
-            }
-        }
+// Record the categories and result of the current round (once per round)
+template <typename Rules>
+void BasicGame<Rules>::closeRound() {
+    if (round == 0 || roundRecorded)
+        return;
+    ALLOC_PHASE(Evaluate);
+
+    Statistics::Outcome outcome = Statistics::Draw;
+    if (lastRoundWinner == &player)
+        outcome = Statistics::Win;
+    else if (lastRoundWinner == &computer)
+        outcome = Statistics::Loss;
+
+    Statistics::instance().recordRound(player.getHand().getRankIndex(),
+                                       computer.getHand().getRankIndex(), outcome);
+    roundRecorded = true;
+    ALLOC_END_ROUND();
+}
+
+// Compare two hands by rank, then primary value, then kickers
+template <typename Rules>
+int BasicGame<Rules>::compareHands(const Hand& a, const Hand& b) {
+    int aRank = a.getRankIndex();
+    int bRank = b.getRankIndex();
+    if (aRank != bRank)
+        return aRank < bRank ? 1 : -1;
+
+    int aPrimary = a.getPrimaryValue();
+    int bPrimary = b.getPrimaryValue();
+    if (aPrimary != bPrimary)
+        return aPrimary > bPrimary ? 1 : -1;
+
+    auto aSec = a.getSecondaryValues();
+    auto bSec = b.getSecondaryValues();
+    for (size_t i = 0; i < std::min(aSec.size(), bSec.size()); ++i) {
+        if (aSec[i] != bSec[i])
+            return aSec[i] > bSec[i] ? 1 : -1;
     }
+    return 0;
+}
 
-    // Fallback to basic strategy
-    if (swapIndex == -1) {
-        if (type == "pair" || type == "trio") {
-            for (int i = 0; i < cards.size(); ++i) {
-                if (cards[i].getValue() != keyVal &&
-                    (swapIndex == -1 || cards[i].getValue() < cards[swapIndex].getValue())) {
-                    swapIndex = i;
-                }
-            }
-        } else if (type == "twop") {
-            for (int i = 0; i < cards.size(); ++i) {
-                if (valCount[cards[i].getValue()] == 1) {
-                    swapIndex = i;
-                    break;
-                }
-            }
-        } else if (type == "high") {
-            for (int i = 0; i < cards.size(); ++i) {
-                if (swapIndex == -1 || cards[i].getValue() < cards[swapIndex].getValue()) {
-                    swapIndex = i;
-                }
-            }
-        }
+// Decide the winner of the current hands and award the point
+template <typename Rules>
+void BasicGame<Rules>::scoreRound() {
+    ALLOC_PHASE(Evaluate);
+    scoreRound(compareHands(player.getHand(), computer.getHand()));
+}
+
+// Award the point for a comparison of the current hands (1 player, -1 computer, 0 draw)
+template <typename Rules>
+void BasicGame<Rules>::scoreRound(int result) {
+    isDraw = (result == 0);
+
+    if (result > 0) {
+        player.incrementScore();
+        lastRoundWinner = &player;
+    } else if (result < 0) {
+        computer.incrementScore();
+        lastRoundWinner = &computer;
+    } else {
+        lastRoundWinner = nullptr;
     }
+}
+
+// Computer replies to the player's swap: the solved strategy when it covers the
+// hand (single 52-card deck, no jokers), otherwise the swap with the best
+// expected category gain over the live cards
+template <typename Rules>
+void BasicGame<Rules>::computerSwapOneCardIfNeeded(int playerSwaps) {
+    int swapIndex = -1;
+    bool solved = deck.getDeckCount() == 1 && deck.getJokerCount() == 0
+                  && computerStrategy.chooseSwap(computer.getHand(), playerSwaps, swapIndex);
+    if (!solved)
+        swapIndex = outsOf(computer).bestSwap(deck);
 
     if (swapIndex != -1) {
+        Hand before = computer.getHand();
         computer.getHand().swapCard({swapIndex}, deck);
+        Statistics::instance().recordSwap(1, compareHands(computer.getHand(), before) > 0);
+        computerSwap = swapIndex;
     }
 }
 
+// Rule variants compiled into the engine (add one line per new policy)
+template class BasicGame<StandardRules>;
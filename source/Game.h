@@ -3,12 +3,24 @@
 
 #include "Player.h"
 #include "Deck.h"
+#include "StrategyTable.h"
+#include "HandOuts.h"
+#include "GameRules.h"
+
+// Two-seat draw poker game parameterised by a rule policy (see GameRules.h)
+template <typename Rules>
+class BasicGame {
+    static_assert(Rules::Seats == 2, "BasicGame seats exactly the player and the computer");
+    static_assert(Rules::HandSize >= 5 && Rules::HandSize <= 7, "Hands are scored on their best five of 5-7 cards");
+    static_assert(Rules::SwapLimit >= 1 && Rules::SwapLimit <= Rules::HandSize, "Swap limit must fit the hand");
 
-class Game {
 public:
-    Game();
+    static constexpr int DrawCards = Rules::Seats * Rules::HandSize; // Cards needed to deal a draw round
+    static constexpr int HoldemCards = Rules::Seats * 2 + 5;         // Cards needed to deal a Hold'em round
+
+    BasicGame();
     void startGame();                              // Start a new game
-    bool dealNextRound();                          // Deal cards for the next round (false if <10 cards)
+    bool dealNextRound();                          // Deal cards for the next round (false if a round no longer fits and no shoe)
     const Player* winnerOfRound() const;           // Get the winner of the current round
     Player const& overallWinner() const;           // Get the overall winner so far
     int currentRound() const;                      // Get the current round number
@@ -16,8 +28,23 @@ public:
     Player& getComputer();                         // Get reference to the computer
     Deck& getDeck();                               // Get reference to the deck
     bool wasDraw() const;                          // Check if the round was a draw
-    void playerSwapCards(const QVector<int>& indices); // Let player swap selected cards
+    bool playerSwapCards(const QVector<int>& indices); // Let player swap selected cards (false if not allowed)
     void evaluateHands();                          // Compare hands and decide the round winner
+    bool dealCards();                              // Deal the next round without scoring it (see scoreRound)
+    bool swapCards(const QVector<int>& indices);   // Swap without re-scoring (see evaluateHands)
+    void scoreRound();                             // Decide the round winner and award the point
+    void scoreRound(int result);                   // Award the point for a comparison already made (see compareHands)
+    void evaluateHands(int result);                // Re-score after a swap from a comparison already made
+    void setHoldem(bool enabled);                  // Two hole cards each plus five shared board cards
+    bool isHoldem() const;                         // Check if Hold'em mode is on
+    const std::vector<Card>& getBoard() const;     // Get the community cards (Hold'em only)
+    int lastComputerSwap() const;                  // Card index the computer swapped this round (-1 if none)
+    quint8 lastPlayerSwap() const;                 // Cards the player actually swapped this round (bit i = card i)
+    void closeRound();                             // Record the current round in the statistics
+    bool loadComputerStrategy(const QString& path); // Use a SwapSolver strategy for the computer's swaps (false if unreadable)
+    const HandOuts& outsOf(const Player& seat);    // Single-card outs of a seat's hand, scored on demand (count them against getDeck())
+
+    static int compareHands(const Hand& a, const Hand& b); // 1 if a wins, -1 if b wins, 0 for a draw
 
 private:
     Player player;
@@ -27,8 +54,20 @@ private:
     Player const* lastRoundWinner;
     bool isDraw = false;
     bool hasSwappedThisRound = false;              // Prevent multiple swaps in a round
-    void computerSwapOneCardIfNeeded();            // Let computer swap one card if needed
+    bool roundRecorded = true;                     // Current round already sent to Statistics
+    bool holdem = false;                           // Deal Hold'em hands instead of five-card draw
+    std::vector<Card> board;                       // Community cards in Hold'em
+    int computerSwap = -1;                         // Card index the computer swapped this round
+    quint8 playerSwap = 0;                         // Cards the player swapped this round (bit i = card i)
+    StrategyTable computerStrategy;                // Solved swap strategy (empty = outs only)
+    HandOuts playerOuts;                           // Outs of the player's hand when last asked (see outsOf)
+    HandOuts computerOuts;                         // Outs of the computer's hand when last asked
+    void computerSwapOneCardIfNeeded(int playerSwaps); // Let computer swap one card if needed
 };
 
+extern template class BasicGame<StandardRules>;
+
+using Game = BasicGame<StandardRules>;             // The standard five-card draw rules
+
 #endif // GAME_H
 
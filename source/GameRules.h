@@ -0,0 +1,16 @@
+#ifndef GAMERULES_H
+#define GAMERULES_H
+
+// Rule policies for BasicGame (see Game.h).
+// A policy is a struct of compile-time constants; BasicGame folds them into
+// its checks, so each variant compiles to fixed limits with no runtime flags.
+// The deck (number of decks and shoe penetration, see Deck::setShoe), jokers
+// and Hold'em are runtime options on every variant, not part of a policy.
+struct StandardRules {
+    static constexpr int HandSize = 5;             // Cards dealt to each seat in draw mode
+    static constexpr int SwapLimit = 3;            // Most cards the player may swap in one round
+    static constexpr int SwapRounds = 4;           // Rounds 1..SwapRounds allow a swap
+    static constexpr int Seats = 2;                // The player and the computer
+};
+
+#endif // GAMERULES_H
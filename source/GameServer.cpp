@@ -0,0 +1,217 @@
+#include "GameServer.h"
+#include "Protocol.h"
+#include "HandEvaluator.h"
+#include <QHostAddress>
+#include <QTimer>
+#include <QtAlgorithms>
+#include <algorithm>
+
+namespace {
+
+// Strength of a packed hand where it orders exactly like Game::compareHands:
+// distinct natural five-card hands and natural Hold'em hands. Invalid otherwise
+// (jokers, shoe duplicates in a five-card hand), leaving the comparison to Game.
+quint32 batchStrength(const Card* cards, int count) {
+    quint64 mask = 0;
+    for (int i = 0; i < count; ++i) {
+        if (cards[i].isJoker())
+            return HandEvaluator::Invalid;
+        mask |= quint64(1) << cards[i].getIndex();
+    }
+    if (count > 5)
+        return HandEvaluator::evaluate(cards, count);
+    return qPopulationCount(mask) == 5 ? HandEvaluator::drawStrength(cards) : HandEvaluator::Invalid;
+}
+
+} // namespace
+
+// Constructor: accept connections as they arrive
+GameServer::GameServer(QObject *parent) : QObject(parent) {
+    connect(&server, &QTcpServer::newConnection, this, &GameServer::onNewConnection);
+}
+
+// Destructor: free all sessions
+GameServer::~GameServer() {
+    qDeleteAll(sessions);
+}
+
+// Listen on the loopback interface
+bool GameServer::listen(quint16 port) {
+    server.setMaxPendingConnections(4096);
+    return server.listen(QHostAddress::LocalHost, port);
+}
+
+// Get number of connected clients
+int GameServer::sessionCount() const {
+    return sessions.size();
+}
+
+// Use a shoe for the tables of clients that connect from now on
+void GameServer::setShoe(int decks, double penetration) {
+    shoeDecks = decks;
+    shoePenetration = penetration;
+}
+
+// Rank both hands in every response from now on
+void GameServer::setRanking(bool enabled) {
+    ranking = enabled;
+}
+
+// Create a session with its own game for every new client
+void GameServer::onNewConnection() {
+    while (QTcpSocket* socket = server.nextPendingConnection()) {
+        Session* session = new Session;
+        session->socket = socket;
+        if (shoeDecks > 0)
+            session->game.getDeck().setShoe(shoeDecks, shoePenetration);
+        socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        sessions.insert(socket, session);
+
+        connect(socket, &QTcpSocket::readyRead, this, [this, session]() { onReadyRead(session); });
+        connect(socket, &QTcpSocket::disconnected, this, [this, session]() { onDisconnected(session); });
+    }
+}
+
+// Handle every complete request waiting on the socket
+void GameServer::onReadyRead(Session* session) {
+    QTcpSocket* socket = session->socket;
+    while (socket->bytesAvailable() >= Protocol::RequestSize) {
+        char request[Protocol::RequestSize];
+        socket->read(request, Protocol::RequestSize);
+        handleRequest(session, quint8(request[0]), quint8(request[1]));
+    }
+}
+
+// Drop a session when its client goes away
+void GameServer::onDisconnected(Session* session) {
+    ready.removeAll(session);
+    sessions.remove(session->socket);
+    session->socket->deleteLater();
+    delete session;
+}
+
+// Apply one action; the showdown is left for the next batch
+void GameServer::handleRequest(Session* session, quint8 opcode, quint8 mask) {
+    if (session->queued) {
+        reply(session, opcode, Protocol::Rejected);  // One action in flight per table
+        return;
+    }
+
+    Game& game = session->game;
+    switch (opcode) {
+    case Protocol::Start:
+        game.startGame();
+        if (!game.dealCards()) {
+            reply(session, opcode, Protocol::GameOver);
+            return;
+        }
+        queueShowdown(session, opcode);
+        return;
+
+    case Protocol::Deal:
+        if (!game.dealCards()) {
+            reply(session, opcode, Protocol::GameOver);
+            return;
+        }
+        queueShowdown(session, opcode);
+        return;
+
+    case Protocol::Swap: {
+        QVector<int> indices;
+        for (int i = 0; i < 5; ++i) {
+            if (mask & (1 << i))
+                indices.append(i);
+        }
+        if (indices.isEmpty() || !game.swapCards(indices)) {
+            reply(session, opcode, Protocol::Rejected);
+            return;
+        }
+        queueShowdown(session, opcode);
+        return;
+    }
+
+    default:
+        reply(session, opcode, Protocol::Rejected);
+    }
+}
+
+// Add a table to the next showdown batch, scheduling the batch if needed
+void GameServer::queueShowdown(Session* session, quint8 opcode) {
+    session->pendingOpcode = opcode;
+    session->queued = true;
+    session->ranksCurrent = false;  // The action dealt or swapped cards
+    ready.append(session);
+
+    if (!tickScheduled) {
+        tickScheduled = true;
+        QTimer::singleShot(0, this, &GameServer::runBatch);
+    }
+}
+
+// Send a response for the session's current round
+void GameServer::reply(Session* session, quint8 opcode, quint8 status) {
+    session->socket->write(Protocol::encodeResponse(opcode, status, session->game, ranksOf(session)));
+}
+
+// Get the session's hand rankings, locating them only if the hands changed since the last response
+const HandRanking::Position* GameServer::ranksOf(Session* session) {
+    if (!ranking)
+        return nullptr;
+    if (!session->ranksCurrent) {
+        Game& game = session->game;
+        const Hand* hands[] = { &game.getPlayer().getHand(), &game.getComputer().getHand() };
+        for (int seat = 0; seat < 2; ++seat) {
+            session->ranks[seat] = game.isHoldem() ? HandRanking::Position()
+                                                   : HandRanking::locate(*hands[seat], *hands[1 - seat]);
+        }
+        session->ranksCurrent = true;
+    }
+    return session->ranks;
+}
+
+// Score every ready table in one pass, then answer them all
+void GameServer::runBatch() {
+    tickScheduled = false;
+
+    // Pack both hands of every ready table into one buffer (player, then computer)
+    const size_t hands = size_t(ready.size()) * 2;
+    batchCards.resize(hands * BatchSlot);
+    batchStrengths.resize(hands);
+    for (int t = 0; t < ready.size(); ++t) {
+        Game& game = ready[t]->game;
+        const std::vector<Card>* seats[] = { &game.getPlayer().getHand().getCards(),
+                                             &game.getComputer().getHand().getCards() };
+        for (int seat = 0; seat < 2; ++seat)
+            std::copy(seats[seat]->begin(), seats[seat]->end(), batchCards.begin() + (t * 2 + seat) * BatchSlot);
+    }
+
+    // One pass over the evaluator for every packed hand
+    for (size_t h = 0; h < hands; ++h) {
+        Game& game = ready[int(h / 2)]->game;
+        const int count = int((h % 2 == 0 ? game.getPlayer() : game.getComputer()).getHand().getCards().size());
+        batchStrengths[h] = batchStrength(batchCards.data() + h * BatchSlot, count);
+    }
+
+    // Award the points; hands the evaluator could not order are compared by Game
+    for (int t = 0; t < ready.size(); ++t) {
+        Session* session = ready[t];
+        Game& game = session->game;
+        const quint32 playerStrength = batchStrengths[t * 2];
+        const quint32 computerStrength = batchStrengths[t * 2 + 1];
+        const int result = playerStrength == HandEvaluator::Invalid || computerStrength == HandEvaluator::Invalid
+            ? Game::compareHands(game.getPlayer().getHand(), game.getComputer().getHand())
+            : (playerStrength > computerStrength) - (playerStrength < computerStrength);
+        if (session->pendingOpcode == Protocol::Swap) {
+            game.evaluateHands(result);
+            game.closeRound();
+        } else {
+            game.scoreRound(result);
+        }
+    }
+
+    for (Session* session : ready) {
+        session->queued = false;
+        reply(session, session->pendingOpcode, Protocol::Ok);
+    }
+    ready.clear();
+}
@@ -0,0 +1,62 @@
+#ifndef GAMESERVER_H
+#define GAMESERVER_H
+
+#include "Game.h"
+#include "HandRanking.h"
+#include <QObject>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QHash>
+#include <QVector>
+
+// Hosts one Game per client connection on a single thread.
+// All sockets are driven by the Qt event loop (poll/epoll underneath), so there is
+// no thread per connection. Actions deal or swap immediately, but the showdown is
+// deferred: every table that became ready during one event-loop pass has its hands
+// packed into one buffer and scored in a single pass over HandEvaluator at the next
+// tick, then the points are awarded and all responses are written.
+class GameServer : public QObject {
+    Q_OBJECT
+
+public:
+    explicit GameServer(QObject *parent = nullptr);
+    ~GameServer();
+
+    bool listen(quint16 port);                    // Listen on 127.0.0.1:port
+    int sessionCount() const;                     // Get number of connected clients
+    void setShoe(int decks, double penetration);  // Deal every new table from a shoe (see Deck::setShoe)
+    void setRanking(bool enabled);                // Send HandRanking percentiles and beaten-by counts (off by default)
+
+private:
+    struct Session {
+        QTcpSocket* socket = nullptr;
+        Game game;
+        quint8 pendingOpcode = 0;                 // Action waiting for the showdown batch
+        bool queued = false;
+        HandRanking::Position ranks[2];           // Player's and computer's ranking for the current hands
+        bool ranksCurrent = false;                // ranks match the hands (cleared by every deal and swap)
+    };
+
+    QTcpServer server;
+    QHash<QTcpSocket*, Session*> sessions;
+    QVector<Session*> ready;                      // Tables waiting for the next batch
+    bool tickScheduled = false;
+    int shoeDecks = 0;                            // Decks per shoe for new tables (0 = single deck)
+    double shoePenetration = 1.0;                 // Fraction of the shoe dealt before reshuffling
+    bool ranking = false;                         // Rank hands in responses (tens of microseconds per hand)
+    std::vector<Card> batchCards;                 // Both hands of every ready table, BatchSlot cards per hand
+    std::vector<quint32> batchStrengths;          // Strength of each packed hand (Invalid = compare through Game)
+
+    void onNewConnection();
+    void onReadyRead(Session* session);
+    void onDisconnected(Session* session);
+    void handleRequest(Session* session, quint8 opcode, quint8 mask);
+    void queueShowdown(Session* session, quint8 opcode);
+    void reply(Session* session, quint8 opcode, quint8 status);
+    const HandRanking::Position* ranksOf(Session* session); // Rank the session's hands once per deal or swap (null when off)
+    void runBatch();                              // Score all ready tables and answer them
+
+    static constexpr int BatchSlot = 7;           // Cards reserved per hand in batchCards (Hold'em hands hold seven)
+};
+
+#endif // GAMESERVER_H
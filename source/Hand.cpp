@@ -1,16 +1,78 @@
 #include "Hand.h"
-#include <map>
+#include "HandEvaluator.h"
 #include <algorithm>
+#include <QtAlgorithms>
+
+namespace {
+
+// Rank indices, in categoryCodes() order
+enum Category {
+    FiveOfAKind, RoyalFlush, StraightFlush, FourOfAKind, FullHouse, Flush,
+    Straight, ThreeOfAKind, TwoPair, OnePair, HighCard, Invalid = -1
+};
+
+// Order two values ascending
+inline void compareSwap(int& a, int& b) {
+    if (b < a)
+        std::swap(a, b);
+}
+
+// Sort five values ascending with the optimal 9-comparator network
+void sortFive(int v[5]) {
+    compareSwap(v[0], v[1]);
+    compareSwap(v[3], v[4]);
+    compareSwap(v[2], v[4]);
+    compareSwap(v[2], v[3]);
+    compareSwap(v[0], v[3]);
+    compareSwap(v[0], v[2]);
+    compareSwap(v[1], v[4]);
+    compareSwap(v[1], v[3]);
+    compareSwap(v[1], v[2]);
+}
+
+// Straight lookup for wild hands, indexed by the 13-bit mask of natural ranks
+// (bit v-2 for value v). Entry = highest top card of a 5-card window that
+// contains every rank in the mask, 0 if none; jokers fill the window's gaps.
+struct WildTables {
+    quint8 straightHigh[1 << 13];
+
+    WildTables() {
+        for (int mask = 0; mask < (1 << 13); ++mask) {
+            straightHigh[mask] = 0;
+            for (int high = 14; high >= 5; --high) {
+                if ((mask & ~straightWindow(high)) == 0) {
+                    straightHigh[mask] = high;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Rank mask of the straight topped by high (5 = A-2-3-4-5)
+    static int straightWindow(int high) {
+        if (high == 5)
+            return (1 << 12) | 0xF;
+        return 0x1F << (high - 6);
+    }
+};
+
+const WildTables& wildTables() {
+    static const WildTables tables;
+    return tables;
+}
+
+} // namespace
 
 // Default constructor
 Hand::Hand() {}
 
-// Deal 5 cards from the deck
-void Hand::dealHand(Deck& deck) {
+// Deal count cards from the deck
+void Hand::dealHand(CardSource& deck, int count) {
     cards.clear();
-    for (int i = 0; i < 5 && deck.cardsRemaining() > 0; ++i) {
+    for (int i = 0; i < count && deck.cardsRemaining() > 0; ++i) {
         cards.push_back(deck.dealCard());
     }
+    resolveJokers();
 }
 
 // Sort cards by value (ascending)
@@ -18,53 +80,43 @@ void Hand::sortValue() {
     std::sort(cards.begin(), cards.end(), [](const Card& a, const Card& b) {
         return a.getValue() < b.getValue();
     });
+    resolveJokers();
 }
 
-// Sort cards by group frequency (higher first), then by value (higher first)
+// Sort cards by group frequency (higher first), then by value (higher first).
+// A stable insertion sort on a stack histogram keeps each group's cards in
+// their original order without allocating.
 void Hand::sortGroup() {
-    std::map<int, std::vector<Card>> freqMap;
-    for (const Card& c : cards) {
-        freqMap[c.getValue()].push_back(c);
-    }
-
-    std::vector<std::vector<Card>> grouped;
-    for (auto& pair : freqMap) {
-        grouped.push_back(pair.second);
-    }
-
-    std::sort(grouped.begin(), grouped.end(), [](const std::vector<Card>& a, const std::vector<Card>& b) {
-        if (a.size() != b.size())
-            return a.size() > b.size();
-        return a[0].getValue() > b[0].getValue();
-    });
+    int counts[RankBuckets] = {0};
+    for (const Card& c : cards)
+        counts[c.getValue()]++;
 
-    cards.clear();
-    for (const auto& group : grouped) {
-        for (const auto& c : group)
-            cards.push_back(c);
+    auto key = [&counts](const Card& c) { return counts[c.getValue()] * 16 + c.getValue(); };
+    for (size_t i = 1; i < cards.size(); ++i) {
+        Card card = cards[i];
+        int cardKey = key(card);
+        size_t j = i;
+        for (; j > 0 && key(cards[j - 1]) < cardKey; --j)
+            cards[j] = cards[j - 1];
+        cards[j] = card;
     }
+    resolveJokers();
 }
 
-// Get frequency counts of card values (sorted descending)
-std::vector<int> Hand::getValueCounts() const {
-    std::map<int, int> counts;
-    for (const Card& c : cards)
+// Fill the rank histogram of the scored cards (index = card value)
+void Hand::getValueCounts(int counts[RankBuckets]) const {
+    std::fill(counts, counts + RankBuckets, 0);
+    for (const Card& c : scoringCards())
         counts[c.getValue()]++;
-
-    std::vector<int> values;
-    for (auto& entry : counts)
-        values.push_back(entry.second);
-
-    std::sort(values.rbegin(), values.rend());
-    return values;
 }
 
 // Check if all cards have the same suit
 bool Hand::isFlush() const {
-    if (cards.empty()) return false;
-    QString suit = cards[0].getSuit();
-    for (const Card& c : cards) {
-        if (c.getSuit() != suit)
+    const std::vector<Card>& hand = scoringCards();
+    if (hand.empty()) return false;
+    int suit = hand[0].getNumber() / 100;
+    for (const Card& c : hand) {
+        if (c.getNumber() / 100 != suit)
             return false;
     }
     return true;
@@ -72,12 +124,14 @@ bool Hand::isFlush() const {
 
 // Check if cards form a straight
 bool Hand::isStraight() const {
-    std::vector<int> vals;
-    for (const Card& c : cards)
-        vals.push_back(c.getValue());
-
-    std::sort(vals.begin(), vals.end());
-    if (vals == std::vector<int>{2, 3, 4, 5, 14}) // Special low-A straight
+    const std::vector<Card>& hand = scoringCards();
+    if (hand.size() != 5) return false;
+    int vals[5];
+    for (int i = 0; i < 5; ++i)
+        vals[i] = hand[i].getValue();
+
+    sortFive(vals);
+    if (vals[0] == 2 && vals[1] == 3 && vals[2] == 4 && vals[3] == 5 && vals[4] == 14) // Special low-A straight
         return true;
 
     for (int i = 0; i < 4; ++i) {
@@ -89,26 +143,19 @@ bool Hand::isStraight() const {
 
 // Return hand type code as string
 QString Hand::getBest() const {
-    if (cards.size() != 5) return "invalid";
-
-    bool flush = isFlush();
-    bool straight = isStraight();
-    std::vector<int> counts = getValueCounts();
+    int rankIndex = getRankIndex();
+    return rankIndex < 0 ? QString("invalid") : categoryCodes()[rankIndex];
+}
 
-    int high = 0;
-    for (const auto& c : cards)
-        high = std::max(high, c.getValue());
+// Set hand from cards (e.g., two hole cards plus the board)
+void Hand::setCards(const std::vector<Card>& newCards) {
+    cards = newCards;
+    resolveJokers();
+}
 
-    if (straight && flush && high == 14) return "ryfl";  // Royal Flush
-    if (straight && flush) return "stfl";                // Straight Flush
-    if (counts[0] == 4) return "four";                   // Four of a Kind
-    if (counts[0] == 3 && counts[1] == 2) return "full"; // Full House
-    if (flush) return "flsh";                            // Flush
-    if (straight) return "strt";                         // Straight
-    if (counts[0] == 3) return "trio";                   // Three of a Kind
-    if (counts[0] == 2 && counts[1] == 2) return "twop"; // Two Pair
-    if (counts[0] == 2) return "pair";                   // One Pair
-    return "high";                                       // High Card
+// Get the strength of the best five cards (6–7 card hands)
+quint32 Hand::getStrength() const {
+    return HandEvaluator::evaluate(cards.data(), static_cast<int>(cards.size()));
 }
 
 // Set hand from encoded values
@@ -119,26 +166,31 @@ void Hand::setHand(const QVector<int>& cardValues) {
         int value = code % 100;
         cards.push_back(Card(value, suit));
     }
+    resolveJokers();
 }
 
 // Swap selected cards and return old cards to the deck
-void Hand::swapCard(const QVector<int>& cardIndices, Deck& deck) {
+quint32 Hand::swapCard(const QVector<int>& cardIndices, CardSource& deck) {
     QVector<int> unique;
     for (int i : cardIndices) {
-        if (!unique.contains(i) && i >= 0 && i < 5)
+        if (!unique.contains(i) && i >= 0 && i < static_cast<int>(cards.size()))
             unique.push_back(i);
     }
 
     std::vector<Card> toReturn;
+    quint32 swapped = 0;
 
     for (int i = 0; i < unique.size() && deck.cardsRemaining() > 0; ++i) {
         toReturn.push_back(cards[unique[i]]);
         cards[unique[i]] = deck.dealCard();
+        swapped |= 1u << unique[i];
     }
+    resolveJokers();
 
     for (const Card& card : toReturn) {
         deck.insertCardRandomly(card);
     }
+    return swapped;
 }
 
 // Get current hand (const reference)
@@ -148,78 +200,211 @@ const std::vector<Card>& Hand::getCards() const {
 
 // Get primary hand value used in comparison
 int Hand::getPrimaryValue() const {
-    QString best = getBest();
-
-    std::map<int, int> valueCount;
-    for (const Card& c : cards)
-        valueCount[c.getValue()]++;
-
-    std::multimap<int, int, std::greater<int>> freqToValue;
-    for (const auto& [val, freq] : valueCount)
-        freqToValue.insert({freq, val});
-
-    if (best == "four" || best == "trio" || best == "pair") {
-        return freqToValue.begin()->second;
-    } else if (best == "twop") {
-        int highestPair = 0;
-        for (const auto& [freq, val] : freqToValue) {
-            if (freq == 2 && val > highestPair)
-                highestPair = val;
+    const std::vector<Card>& hand = scoringCards();
+    if (hand.size() > 5) return HandEvaluator::value(getStrength(), 0);
+
+    int counts[RankBuckets];
+    getValueCounts(counts);
+
+    switch (getRankIndex()) {
+    case FiveOfAKind:
+    case FourOfAKind:
+    case ThreeOfAKind:
+    case OnePair: {
+        // The only group of its size
+        int best = 0;
+        for (int v = 2; v < RankBuckets; ++v) {
+            if (counts[v] > counts[best])
+                best = v;
         }
-        return highestPair;
-    } else if (best == "full") {
-        for (const auto& [freq, val] : freqToValue) {
-            if (freq == 3)
-                return val;
+        return best;
+    }
+    case TwoPair:
+    case FullHouse: {
+        int size = getRankIndex() == FullHouse ? 3 : 2;
+        for (int v = RankBuckets - 1; v >= 2; --v) {
+            if (counts[v] == size)
+                return v;
         }
-    } else if (best == "strt" || best == "stfl" || best == "ryfl") {
-        std::vector<int> vals;
-        for (const Card& c : cards)
-            vals.push_back(c.getValue());
-        std::sort(vals.begin(), vals.end());
-        if (vals == std::vector<int>{2, 3, 4, 5, 14})
-            return 5;
-        return vals.back();
-    } else if (best == "flsh" || best == "high") {
-        int maxVal = 0;
-        for (const auto& c : cards)
-            maxVal = std::max(maxVal, c.getValue());
-        return maxVal;
-    }
-
-    return 0;
-}
-
-// Get secondary values for tie-breaking
-std::vector<int> Hand::getSecondaryValues() const {
-    std::map<int, int> valueCount;
-    for (const Card& c : cards)
-        valueCount[c.getValue()]++;
+        return 0;
+    }
+    case Straight:
+    case StraightFlush:
+    case RoyalFlush:
+        if (counts[14] && counts[2] && counts[3] && counts[4] && counts[5])
+            return 5;  // A-2-3-4-5
+        [[fallthrough]];
+    case Flush:
+    case HighCard:
+        for (int v = RankBuckets - 1; v >= 2; --v) {
+            if (counts[v])
+                return v;
+        }
+        return 0;
+    default:
+        return 0;
+    }
+}
+
+// Get secondary values for tie-breaking: every card not of the primary value, highest first
+Hand::Kickers Hand::getSecondaryValues() const {
+    const std::vector<Card>& hand = scoringCards();
+    Kickers kickers;
+    if (hand.size() > 5) {
+        quint32 strength = getStrength();
+        for (int i = 1; i < 5 && HandEvaluator::value(strength, i) > 0; ++i)
+            kickers.push_back(HandEvaluator::value(strength, i));
+        return kickers;
+    }
 
+    int counts[RankBuckets];
+    getValueCounts(counts);
     int primary = getPrimaryValue();
 
-    std::multimap<int, int, std::greater<int>> freqToValue;
-    for (const auto& [val, freq] : valueCount) {
-        if (val != primary) {
-            freqToValue.insert({freq, val});
-        }
+    for (int v = RankBuckets - 1; v >= 2; --v) {
+        if (v == primary)
+            continue;
+        for (int i = 0; i < counts[v]; ++i)
+            kickers.push_back(v);
     }
+    return kickers;
+}
 
-    std::vector<int> secondaryValues;
-    for (const auto& [freq, val] : freqToValue) {
-        for (int i = 0; i < freq; ++i)
-            secondaryValues.push_back(val);
+// Get hand rank index (lower = stronger), -1 if the hand is invalid
+int Hand::getRankIndex() const {
+    const std::vector<Card>& hand = scoringCards();
+    if (hand.size() > 5) return HandEvaluator::rankIndex(getStrength());
+    if (hand.size() != 5) return Invalid;
+
+    bool flush = isFlush();
+    bool straight = isStraight();
+
+    // Two largest group sizes and the value span, straight off the histogram
+    int counts[RankBuckets];
+    getValueCounts(counts);
+    int first = 0;
+    int second = 0;
+    int high = 0;
+    int low = 14;
+    for (int v = 2; v < RankBuckets; ++v) {
+        if (counts[v] == 0)
+            continue;
+        high = v;
+        low = std::min(low, v);
+        if (counts[v] > first) {
+            second = first;
+            first = counts[v];
+        } else if (counts[v] > second) {
+            second = counts[v];
+        }
     }
 
-    std::sort(secondaryValues.begin(), secondaryValues.end(), std::greater<>());
-    return secondaryValues;
+    if (first >= 5) return FiveOfAKind;                     // Five of a Kind (jokers or a multi-deck shoe)
+    if (straight && flush && high == 14 && low == 10) return RoyalFlush; // Royal Flush (not A-2-3-4-5)
+    if (straight && flush) return StraightFlush;
+    if (first == 4) return FourOfAKind;
+    if (first == 3 && second == 2) return FullHouse;
+    if (flush) return Flush;
+    if (straight) return Straight;
+    if (first == 3) return ThreeOfAKind;
+    if (first == 2 && second == 2) return TwoPair;
+    if (first == 2) return OnePair;
+    return HighCard;
 }
 
-// Get hand rank index (lower = stronger)
-int Hand::getRankIndex() const {
-    QStringList ranks = {
-        "ryfl", "stfl", "four", "full", "flsh", "strt",
+// Get all category codes, strongest first
+const QStringList& Hand::categoryCodes() {
+    static const QStringList ranks = {
+        "five", "ryfl", "stfl", "four", "full", "flsh", "strt",
         "trio", "twop", "pair", "high"
     };
-    return ranks.indexOf(getBest());
+    return ranks;
+}
+
+// Replace each joker by the card that makes the strongest hand.
+// The natural cards' rank histogram, rank mask and suit decide the best category
+// directly (straight windows come from WildTables), so no substitution is tried.
+void Hand::resolveJokers() {
+    resolved.clear();
+
+    int wild = 0;
+    int counts[15] = {0};
+    int rankMask = 0;
+    int suit = 0;
+    bool sameSuit = true;
+    for (const Card& c : cards) {
+        if (c.isJoker()) {
+            ++wild;
+            continue;
+        }
+        counts[c.getValue()]++;
+        rankMask |= 1 << (c.getValue() - 2);
+        int s = c.getNumber() / 100;
+        if (suit != 0 && s != suit)
+            sameSuit = false;
+        suit = s;
+    }
+    if (wild == 0 || cards.size() != 5)
+        return;
+    if (suit == 0)
+        suit = 4;
+
+    // Best group for the jokers to join: largest count, then highest value
+    int groupValue = 14;
+    int maxCount = 0;
+    int pairs = 0;
+    for (int v = 14; v >= 2; --v) {
+        if (counts[v] > maxCount) {
+            maxCount = counts[v];
+            groupValue = v;
+        }
+        if (counts[v] == 2)
+            ++pairs;
+    }
+
+    int naturals = static_cast<int>(cards.size()) - wild;
+    int straightHigh = int(qPopulationCount(quint32(rankMask))) == naturals
+                       ? wildTables().straightHigh[rankMask] : 0;
+    bool groupBeatsFlush = maxCount + wild >= 4 || (wild == 1 && pairs == 2);
+
+    int jokerValues[5];
+    int jokerCount = 0;
+    if (maxCount + wild >= 5) {
+        // Five of a kind
+        std::fill(jokerValues, jokerValues + wild, groupValue);
+    } else if (sameSuit && straightHigh) {
+        // Straight flush: fill the gaps in the window
+        int window = WildTables::straightWindow(straightHigh);
+        for (int v = 14; v >= 2; --v) {
+            if ((window & ~rankMask) & (1 << (v - 2)))
+                jokerValues[jokerCount++] = v;
+        }
+    } else if (groupBeatsFlush) {
+        // Four of a kind, or full house from two pair
+        std::fill(jokerValues, jokerValues + wild, groupValue);
+    } else if (sameSuit) {
+        // Flush: an Ace if missing, every other joker a King (the best kickers,
+        // since values equal to the primary Ace do not count as kickers)
+        std::fill(jokerValues, jokerValues + wild, 13);
+        if (!(rankMask & (1 << 12)))
+            jokerValues[0] = 14;
+    } else if (straightHigh) {
+        int window = WildTables::straightWindow(straightHigh);
+        for (int v = 14; v >= 2; --v) {
+            if ((window & ~rankMask) & (1 << (v - 2)))
+                jokerValues[jokerCount++] = v;
+        }
+    } else {
+        // Three of a kind or a pair
+        std::fill(jokerValues, jokerValues + wild, groupValue);
+    }
+
+    int next = 0;
+    for (const Card& c : cards)
+        resolved.push_back(c.isJoker() ? Card(jokerValues[next++], suit) : c);
+}
+
+// Get the cards evaluation should look at (jokers substituted)
+const std::vector<Card>& Hand::scoringCards() const {
+    return resolved.empty() ? cards : resolved;
 }
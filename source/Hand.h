@@ -2,35 +2,60 @@
 #define HAND_H
 
 #include "Card.h"
-#include "Deck.h"
+#include "CardSource.h"
 #include <QVector>
 #include <QString>
+#include <QStringList>
 #include <vector>
 
 class Hand {
 public:
+    // Tie-break values held inline, so comparing hands never allocates
+    class Kickers {
+    public:
+        void push_back(int value) { if (count < Capacity) values[count++] = value; } // Append a value (extra values are dropped)
+        size_t size() const { return count; }                                        // Number of values
+        int operator[](size_t i) const { return values[i]; }                          // Value at position i
+        const int* begin() const { return values; }                                   // First value
+        const int* end() const { return values + count; }                             // Past the last value
+
+    private:
+        static constexpr size_t Capacity = 5;
+        int values[Capacity] = {};
+        size_t count = 0;
+    };
+
     Hand();
 
-    void dealHand(Deck& deck);                     // Deal 5 cards from the deck
+    void dealHand(CardSource& deck, int count = 5); // Deal count cards from the deck
     void sortValue();                              // Sort cards by value (ascending)
     void sortGroup();                              // Sort cards by value frequency (e.g., pairs first)
 
-    QString getBest() const;                       // Get hand type (e.g., "four", "flsh")
+    QString getBest() const;                       // Get hand type (e.g., "four", "flsh"); 7 cards use the best five
     int getPrimaryValue() const;                   // Get main value for comparison (e.g., pair/triple)
-    std::vector<int> getSecondaryValues() const;   // Get kicker values for tie-breaking
+    Kickers getSecondaryValues() const;            // Get kicker values for tie-breaking
     int getRankIndex() const;                      // Get rank index (lower = stronger hand)
 
+    static constexpr int CategoryCount = 11;       // Number of hand categories
+    static const QStringList& categoryCodes();     // Category codes ordered by rank index
+
     void setHand(const QVector<int>& cardValues);  // Set hand using encoded card values (e.g., 412 = 12 of Spades)
+    void setCards(const std::vector<Card>& newCards); // Set hand from cards (5, or 7 for Hold'em)
+    quint32 getStrength() const;                   // Best-five strength for 6–7 cards (higher = stronger)
 
-    void swapCard(const QVector<int>& cardIndices, Deck& deck); // Swap selected cards from deck
+    quint32 swapCard(const QVector<int>& cardIndices, CardSource& deck); // Swap selected cards from deck; returns the positions swapped (bit i = card i)
     const std::vector<Card>& getCards() const;     // Get all cards in hand
 
 private:
     std::vector<Card> cards;
+    std::vector<Card> resolved;                    // Cards with jokers replaced by their best values (empty if no jokers)
 
+    void resolveJokers();                          // Refresh resolved after the cards change
+    const std::vector<Card>& scoringCards() const; // Cards used for evaluation
     bool isFlush() const;                          // Check if all cards share the same suit
     bool isStraight() const;                       // Check if card values are consecutive
-    std::vector<int> getValueCounts() const;       // Get count of each card value in hand
+    static constexpr int RankBuckets = Card::JokerValue + 1; // Histogram buckets, indexed by card value (2–14, jokers 15)
+    void getValueCounts(int counts[RankBuckets]) const; // Fill the count of each card value in hand
 };
 
 #endif // HAND_H
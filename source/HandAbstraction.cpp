@@ -0,0 +1,94 @@
+#include "HandAbstraction.h"
+#include <QHash>
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+constexpr int Suits = 4;
+constexpr int DeckSize = 52;
+
+// Canonical key of a hand given its per-suit rank masks; suitOrder (optional)
+// receives the suits from the first canonical slot to the last
+quint64 canonicalKey(const int masks[Suits], int suitOrder[Suits] = nullptr) {
+    int order[Suits] = { 0, 1, 2, 3 };
+    std::stable_sort(order, order + Suits, [masks](int a, int b) { return masks[a] > masks[b]; });
+
+    quint64 key = 0;
+    for (int slot = 0; slot < Suits; ++slot) {
+        key = (key << 13) | quint64(masks[order[slot]]);
+        if (suitOrder)
+            suitOrder[slot] = order[slot];
+    }
+    return key;
+}
+
+// Class id of every canonical key, numbered in ascending key order
+const QHash<quint64, int>& classIds() {
+    static const QHash<quint64, int> ids = [] {
+        std::vector<quint64> keys;
+        keys.reserve(2598960);
+        int masks[Suits];
+        int cards[HandAbstraction::HandSize];
+        for (cards[0] = 0; cards[0] < DeckSize; ++cards[0])
+        for (cards[1] = cards[0] + 1; cards[1] < DeckSize; ++cards[1])
+        for (cards[2] = cards[1] + 1; cards[2] < DeckSize; ++cards[2])
+        for (cards[3] = cards[2] + 1; cards[3] < DeckSize; ++cards[3])
+        for (cards[4] = cards[3] + 1; cards[4] < DeckSize; ++cards[4]) {
+            std::fill(masks, masks + Suits, 0);
+            for (int index : cards)
+                masks[index / 13] |= 1 << (index % 13);
+            keys.push_back(canonicalKey(masks));
+        }
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+        QHash<quint64, int> table;
+        table.reserve(int(keys.size()));
+        for (size_t i = 0; i < keys.size(); ++i)
+            table.insert(keys[i], int(i));
+        return table;
+    }();
+    return ids;
+}
+
+} // namespace
+
+// Get the class of five cards and, optionally, their canonical order
+int HandAbstraction::classOf(const Card* cards, int order[HandSize]) {
+    int masks[Suits] = {0};
+    for (int i = 0; i < HandSize; ++i) {
+        if (cards[i].isJoker())
+            return -1;
+        int bit = 1 << (cards[i].getValue() - 2);
+        int& mask = masks[cards[i].getNumber() / 100 - 1];
+        if (mask & bit)
+            return -1;  // The same card twice (multi-deck shoe)
+        mask |= bit;
+    }
+
+    int suitOrder[Suits];
+    int handClass = classIds().value(canonicalKey(masks, suitOrder), -1);
+
+    // Canonical card order: by canonical suit slot, then by value (highest first)
+    if (order && handClass >= 0) {
+        int slotOf[Suits];
+        for (int slot = 0; slot < Suits; ++slot)
+            slotOf[suitOrder[slot]] = slot;
+        for (int i = 0; i < HandSize; ++i)
+            order[i] = i;
+        std::sort(order, order + HandSize, [cards, &slotOf](int a, int b) {
+            int slotA = slotOf[cards[a].getNumber() / 100 - 1];
+            int slotB = slotOf[cards[b].getNumber() / 100 - 1];
+            if (slotA != slotB)
+                return slotA < slotB;
+            return cards[a].getValue() > cards[b].getValue();
+        });
+    }
+    return handClass;
+}
+
+// Get the number of classes (builds the table)
+int HandAbstraction::classCount() {
+    return classIds().size();
+}
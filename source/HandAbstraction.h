@@ -0,0 +1,21 @@
+#ifndef HANDABSTRACTION_H
+#define HANDABSTRACTION_H
+
+#include "Card.h"
+
+// Suit-isomorphic classes of five-card hands from one 52-card deck.
+// Hands that differ only by a renaming of suits play identically, so the
+// 2,598,960 hands fold into 134,459 classes. A class is keyed by the four
+// per-suit rank masks in canonical (descending) order; the same suit order
+// gives every hand a canonical card order, so a strategy can name cards by
+// canonical position and apply to every hand of the class.
+class HandAbstraction {
+public:
+    static constexpr int HandSize = 5;
+    static constexpr int Classes = 134459;
+
+    static int classOf(const Card* cards, int order[HandSize] = nullptr); // Class id (-1 for jokers/duplicates); order[p] = hand index of canonical card p
+    static int classCount();                       // Number of classes found (builds the class table on first use)
+};
+
+#endif // HANDABSTRACTION_H
@@ -0,0 +1,192 @@
+#include "HandEvaluator.h"
+#include "Hand.h"
+
+namespace {
+
+// Rank masks use bit v-2 for value v (2..14)
+struct StraightTable {
+    quint8 high[1 << 13];   // Top card of the best straight in a rank mask, 0 if none
+
+    StraightTable() {
+        for (int mask = 0; mask < (1 << 13); ++mask) {
+            high[mask] = 0;
+            for (int top = 14; top >= 6; --top) {
+                int window = 0x1F << (top - 6);
+                if ((mask & window) == window) {
+                    high[mask] = top;
+                    break;
+                }
+            }
+            int wheel = (1 << 12) | 0xF;  // A-2-3-4-5
+            if (!high[mask] && (mask & wheel) == wheel)
+                high[mask] = 5;
+        }
+    }
+};
+
+const StraightTable& straights() {
+    static const StraightTable table;
+    return table;
+}
+
+// Pack a category (rank index) and up to five tie-break values
+quint32 pack(int rankIndex, int v0, int v1 = 0, int v2 = 0, int v3 = 0, int v4 = 0) {
+    quint32 category = Hand::CategoryCount - 1 - rankIndex;
+    return (category << 20) | (v0 << 16) | (v1 << 12) | (v2 << 8) | (v3 << 4) | v4;
+}
+
+// Highest value in a rank mask, removing it from the mask
+int popHighest(int& mask) {
+    if (mask == 0)
+        return 0;
+    int bit = 31 - qCountLeadingZeroBits(quint32(mask));
+    mask &= ~(1 << bit);
+    return bit + 2;
+}
+
+} // namespace
+
+// Evaluate the best five-card hand among count natural cards (Invalid if any is a joker)
+quint32 HandEvaluator::evaluate(const Card* cards, int count) {
+    if (count < 5)
+        return Invalid;
+    int suitMask[5] = {0};
+    int suitCount[5] = {0};
+    int counts[15] = {0};
+    for (int i = 0; i < count; ++i) {
+        if (cards[i].isJoker())
+            return Invalid;
+        int v = cards[i].getValue();
+        int s = cards[i].getNumber() / 100;
+        suitMask[s] |= 1 << (v - 2);
+        suitCount[s]++;
+        counts[v]++;
+    }
+
+    const StraightTable& table = straights();
+    static const QStringList& codes = Hand::categoryCodes();
+    static const int five = codes.indexOf("five"), ryfl = codes.indexOf("ryfl"), stfl = codes.indexOf("stfl"),
+                     four = codes.indexOf("four"), full = codes.indexOf("full"), flsh = codes.indexOf("flsh"),
+                     strt = codes.indexOf("strt"), trio = codes.indexOf("trio"), twop = codes.indexOf("twop"),
+                     pair = codes.indexOf("pair"), high = codes.indexOf("high");
+
+    // Five copies of one value (a multi-deck shoe) beat everything, as in Hand
+    for (int v = 14; v >= 2; --v) {
+        if (counts[v] >= 5)
+            return pack(five, v);
+    }
+
+    // Flush path: at most one suit can hold five of seven cards, counting duplicate copies
+    int flushSuit = 0;
+    for (int s = 1; s <= 4; ++s) {
+        if (suitCount[s] >= 5)
+            flushSuit = s;
+    }
+    if (flushSuit) {
+        int top = table.high[suitMask[flushSuit]];
+        if (top == 14)
+            return pack(ryfl, 14);
+        if (top)
+            return pack(stfl, top);
+    }
+
+    // Rank path: masks of values held at least once, twice, three and four times
+    int any = 0, pairs = 0, trips = 0, quads = 0;
+    for (int v = 2; v <= 14; ++v) {
+        int bit = 1 << (v - 2);
+        if (counts[v] >= 1) any |= bit;
+        if (counts[v] == 2) pairs |= bit;
+        if (counts[v] == 3) trips |= bit;
+        if (counts[v] == 4) quads |= bit;
+    }
+
+    if (quads) {
+        int q = popHighest(quads);
+        int rest = any & ~(1 << (q - 2));
+        return pack(four, q, popHighest(rest));
+    }
+
+    if (trips && (qPopulationCount(quint32(trips)) >= 2 || pairs)) {
+        int t = popHighest(trips);
+        int pairsLeft = trips | pairs;
+        return pack(full, t, popHighest(pairsLeft));
+    }
+
+    if (flushSuit) {
+        // The five highest cards of the suit, duplicate copies included
+        int v[5] = {0};
+        int next = 0;
+        for (int value = 14; value >= 2 && next < 5; --value) {
+            for (int i = 0; i < count && next < 5; ++i) {
+                if (cards[i].getValue() == value && cards[i].getNumber() / 100 == flushSuit)
+                    v[next++] = value;
+            }
+        }
+        return pack(flsh, v[0], v[1], v[2], v[3], v[4]);
+    }
+
+    if (int top = table.high[any])
+        return pack(strt, top);
+
+    if (trips) {
+        int t = popHighest(trips);
+        int rest = any & ~(1 << (t - 2));
+        int k0 = popHighest(rest);
+        return pack(trio, t, k0, popHighest(rest));
+    }
+
+    // Two pair follows the draw rule: high pair, then the other three cards
+    // highest first, so a kicker above the low pair is compared before it
+    if (qPopulationCount(quint32(pairs)) >= 2) {
+        int p0 = popHighest(pairs), p1 = popHighest(pairs);
+        int rest = any & ~(1 << (p0 - 2)) & ~(1 << (p1 - 2));
+        int k = popHighest(rest);
+        return k > p1 ? pack(twop, p0, k, p1, p1) : pack(twop, p0, p1, p1, k);
+    }
+
+    if (pairs) {
+        int p = popHighest(pairs);
+        int rest = any & ~(1 << (p - 2));
+        int k0 = popHighest(rest), k1 = popHighest(rest);
+        return pack(pair, p, k0, k1, popHighest(rest));
+    }
+
+    int m = any;
+    int v0 = popHighest(m), v1 = popHighest(m), v2 = popHighest(m), v3 = popHighest(m);
+    return pack(high, v0, v1, v2, v3, popHighest(m));
+}
+
+// Strength of exactly five cards under the draw game's tie-break rule:
+// category, primary value, then every other card's value highest first
+quint32 HandEvaluator::drawStrength(const Card* cards) {
+    quint32 strength = evaluate(cards, 5);
+    if (strength == Invalid)
+        return Invalid;
+    int primary = value(strength, 0);
+
+    int counts[15] = {0};
+    for (int i = 0; i < 5; ++i)
+        counts[cards[i].getValue()]++;
+
+    int kickers[4] = {0};
+    int next = 0;
+    for (int v = 14; v >= 2 && next < 4; --v) {
+        if (v == primary)
+            continue;
+        for (int i = 0; i < counts[v] && next < 4; ++i)
+            kickers[next++] = v;
+    }
+    return pack(rankIndex(strength), primary, kickers[0], kickers[1], kickers[2], kickers[3]);
+}
+
+// Get the category of a strength as a rank index
+int HandEvaluator::rankIndex(quint32 strength) {
+    if (strength == Invalid)
+        return -1;
+    return Hand::CategoryCount - 1 - static_cast<int>(strength >> 20);
+}
+
+// Get the i-th tie-break value (0 = primary)
+int HandEvaluator::value(quint32 strength, int i) {
+    return (strength >> (16 - 4 * i)) & 0xF;
+}
@@ -0,0 +1,25 @@
+#ifndef HANDEVALUATOR_H
+#define HANDEVALUATOR_H
+
+#include "Card.h"
+#include <QtGlobal>
+
+// Direct best-five evaluation for 5–7 cards (used for Hold'em showdowns).
+// Cards are folded into per-suit counts and rank masks and a rank histogram;
+// groups fall out of the histogram and flushes/straights out of the suits, so
+// none of the 21 five-card subsets of a 7-card hand is ever built. Duplicate
+// cards from a multi-deck shoe count once per copy. Jokers are not resolved
+// here (only Hand resolves them, for five cards), so they make the result
+// Invalid rather than being scored as something else.
+class HandEvaluator {
+public:
+    static constexpr quint32 Invalid = 0;       // Strength of a hand evaluate() cannot score (no real hand packs to 0)
+
+    static quint32 evaluate(const Card* cards, int count); // Strength of the best five cards (higher = stronger), Invalid with jokers or under five cards
+    static quint32 drawStrength(const Card* cards); // Five cards, no jokers: ordered exactly like Game::compareHands
+
+    static int rankIndex(quint32 strength);     // Category as a Hand::categoryCodes() index (lower = stronger), -1 if Invalid
+    static int value(quint32 strength, int i);  // i-th tie-break value (2–14), 0 if unused
+};
+
+#endif // HANDEVALUATOR_H
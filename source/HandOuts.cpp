@@ -0,0 +1,184 @@
+#include "HandOuts.h"
+#include "HandEvaluator.h"
+#include <QtAlgorithms>
+#include <algorithm>
+
+namespace {
+
+constexpr int Values = 13;  // Natural card values; Card::getIndex() = value rank * 4 + suit
+
+// Category of five cards: the direct evaluator for distinct natural cards,
+// a scratch Hand (which resolves jokers) for the rest
+int categoryOf(const Card* cards, Hand& scratch, std::vector<Card>& scratchCards) {
+    quint64 mask = 0;
+    bool natural = true;
+    for (int i = 0; i < HandOuts::Positions; ++i) {
+        natural = natural && !cards[i].isJoker();
+        mask |= quint64(1) << cards[i].getIndex();
+    }
+    if (natural && qPopulationCount(mask) == HandOuts::Positions)
+        return HandEvaluator::rankIndex(HandEvaluator::drawStrength(cards));
+
+    scratchCards.assign(cards, cards + HandOuts::Positions);
+    scratch.setCards(scratchCards);
+    return scratch.getRankIndex();
+}
+
+} // namespace
+
+// Keep the per-category card masks in step with the hand and the deck's live cards
+void HandOuts::update(const Hand& hand, const CardSource& deck) {
+    const std::vector<Card>& cards = hand.getCards();
+    if (cards.size() != size_t(Positions)) {
+        valid = false;
+        return;
+    }
+
+    bool sameHand = valid;
+    for (int i = 0; sameHand && i < Positions; ++i)
+        sameHand = cards[i].getIndex() == scoredCards[i];
+
+    const quint64 liveCards = deck.liveMask();
+    if (sameHand) {
+        // Same hand: drop the cards dealt since the last update and score only the returned ones
+        quint64 dealt = scoredLive & ~liveCards;
+        quint64 returned = liveCards & ~scoredLive;
+        if (dealt == 0 && returned == 0)
+            return;
+        for (auto& row : makes) {
+            for (quint64& cardMask : row)
+                cardMask &= ~dealt;
+        }
+        scoreSwaps(returned);
+    } else {
+        valid = true;
+        current = hand.getRankIndex();
+        for (auto& row : makes)
+            std::fill(row, row + Hand::CategoryCount, 0);
+        for (int i = 0; i < Positions; ++i) {
+            scoredCards[i] = cards[i].getIndex();
+            values[i] = cards[i].getValue();
+            jokers[i] = cards[i].isJoker();
+        }
+        scoreSwaps(liveCards);
+    }
+    scoredLive = liveCards;
+
+    // Each card counts towards the strongest category any swap makes with it (jokers are never swapped out)
+    std::fill(reach, reach + Hand::CategoryCount, 0);
+    quint64 covered = 0;
+    for (int category = 0; category < current; ++category) {
+        for (int position = 0; position < Positions; ++position) {
+            if (!jokers[position])
+                reach[category] |= makes[position][category] & ~covered;
+        }
+        covered |= reach[category];
+    }
+}
+
+// Add the categories every position makes with each card in the mask to the per-position masks
+void HandOuts::scoreSwaps(quint64 candidates) {
+    Card trial[Positions];
+    for (int i = 0; i < Positions; ++i)
+        trial[i] = Card::fromIndex(scoredCards[i]);
+
+    for (int position = 0; position < Positions; ++position) {
+        // Four distinct natural cards leave only the new card's value and whether
+        // it matches their common suit, so they take one score per value (two
+        // for the flush suit) present in the mask; jokers and duplicate copies
+        // go through the scratch Hand
+        quint64 others = 0;
+        int suits = 0;
+        bool natural = true;
+        for (int i = 0; i < Positions; ++i) {
+            if (i == position)
+                continue;
+            natural = natural && !jokers[i];
+            others |= quint64(1) << scoredCards[i];
+            suits |= 1 << (scoredCards[i] % 4);
+        }
+        quint64 slow = candidates;
+        if (natural && qPopulationCount(others) == Positions - 1) {
+            int flushSuit = qPopulationCount(quint32(suits)) == 1 ? int(qCountTrailingZeroBits(quint32(suits))) : -1;
+            for (int value = 0; value < Values; ++value) {
+                quint64 valueCards = candidates & ~others & (quint64(0xF) << (value * 4));
+                if (valueCards == 0)
+                    continue;
+                quint64 suitedCard = flushSuit >= 0 ? quint64(1) << (value * 4 + flushSuit) : 0;
+                if (valueCards & ~suitedCard) {
+                    trial[position] = Card::fromIndex(value * 4 + (flushSuit + 1) % 4);
+                    makes[position][HandEvaluator::rankIndex(HandEvaluator::evaluate(trial, Positions))] |= valueCards & ~suitedCard;
+                }
+                if (valueCards & suitedCard) {
+                    trial[position] = Card::fromIndex(value * 4 + flushSuit);
+                    makes[position][HandEvaluator::rankIndex(HandEvaluator::evaluate(trial, Positions))] |= suitedCard;
+                }
+                slow &= ~valueCards;
+            }
+        }
+
+        for (; slow != 0; slow &= slow - 1) {
+            int index = int(qCountTrailingZeroBits(slow));
+            trial[position] = Card::fromIndex(index);
+            int made = categoryOf(trial, scratch, scratchCards);
+            if (made >= 0)
+                makes[position][made] |= quint64(1) << index;
+        }
+        trial[position] = Card::fromIndex(scoredCards[position]);
+    }
+}
+
+// Check if the hand could be scored
+bool HandOuts::isValid() const {
+    return valid;
+}
+
+// Get the hand's current category
+int HandOuts::category() const {
+    return current;
+}
+
+// Count the live cards whose best swap lifts the hand to this category
+int HandOuts::count(int category, const CardSource& deck) const {
+    if (!valid || category < 0 || category >= current)
+        return 0;
+    return deck.liveCount(reach[category]);
+}
+
+// Count the live cards that improve the hand by some swap
+int HandOuts::total(const CardSource& deck) const {
+    quint64 outs = 0;
+    for (int category = 0; category < current; ++category)
+        outs |= reach[category];
+    return valid ? deck.liveCount(outs) : 0;
+}
+
+// Average change in category (positive = stronger) from swapping a position for a random live card
+double HandOuts::expectedGain(int position, const CardSource& deck) const {
+    if (!valid || position < 0 || position >= Positions)
+        return 0.0;
+    int live = deck.liveCount(deck.liveMask());
+    if (live == 0)
+        return 0.0;
+
+    qint64 gain = 0;
+    for (int category = 0; category < Hand::CategoryCount; ++category)
+        gain += qint64(current - category) * deck.liveCount(makes[position][category]);
+    return double(gain) / live;
+}
+
+// Pick the swap with the best expected gain, discarding the lower card on ties; stand unless it helps
+int HandOuts::bestSwap(const CardSource& deck) const {
+    int choice = -1;
+    double bestGain = 0.0;
+    for (int position = 0; position < Positions; ++position) {
+        if (!valid || jokers[position])
+            continue;
+        double gain = expectedGain(position, deck);
+        if (gain > bestGain + 1e-9 || (choice != -1 && gain > bestGain - 1e-9 && values[position] < values[choice])) {
+            choice = position;
+            bestGain = std::max(bestGain, gain);
+        }
+    }
+    return choice;
+}
@@ -0,0 +1,46 @@
+#ifndef HANDOUTS_H
+#define HANDOUTS_H
+
+#include "Hand.h"
+#include "CardSource.h"
+#include <QtGlobal>
+#include <vector>
+
+// Single-card outs of a five-card hand against the cards left in a deck.
+// update() scores the category every (position, live card) swap would make
+// and folds the results into 54-bit card masks (bit = Card::getIndex()) per
+// category. Counting outs is then a masked popcount against
+// CardSource::liveCount(). Only cards in the deck's live mask are scored (so
+// no jokers unless the deck has them). While the hand stays the same, update()
+// follows the deck incrementally: dealt cards are masked out and each
+// returned card costs one score per position. A new hand is rescored in full.
+class HandOuts {
+public:
+    static constexpr int Positions = 5;             // Cards in a draw hand
+    static constexpr int CardIndices = 54;          // 52 cards and two jokers
+
+    void update(const Hand& hand, const CardSource& deck); // Follow the deck's dealt and returned cards; rescore a new hand
+    bool isValid() const;                           // False unless the hand holds exactly five cards
+    int category() const;                           // Current category (Hand::getRankIndex())
+
+    int count(int category, const CardSource& deck) const; // Live cards whose best swap makes this stronger category
+    int total(const CardSource& deck) const;              // Live cards that improve the category by any swap
+    double expectedGain(int position, const CardSource& deck) const; // Mean category steps gained by swapping this card for a random live one
+    int bestSwap(const CardSource& deck) const;           // Position with the highest positive expected gain (-1 = stand)
+
+private:
+    bool valid = false;
+    int current = Hand::CategoryCount - 1;
+    quint64 reach[Hand::CategoryCount] = {};        // Cards whose best swap makes each category (stronger ones only)
+    quint64 makes[Positions][Hand::CategoryCount] = {}; // Cards that make each category when swapped into a position
+    int values[Positions] = {};                     // Card values, to break ties towards discarding low cards
+    bool jokers[Positions] = {};                    // Positions holding a joker (never discarded)
+    int scoredCards[Positions] = {};                // Card::getIndex() of the hand last scored
+    quint64 scoredLive = 0;                         // Live mask the masks were last brought up to date with
+    Hand scratch;                                   // Resolves jokers and duplicates, reused between updates
+    std::vector<Card> scratchCards;
+
+    void scoreSwaps(quint64 candidates);            // Add every position's category with each candidate card to makes
+};
+
+#endif // HANDOUTS_H
@@ -0,0 +1,291 @@
+#include "HandRanking.h"
+#include "HandEvaluator.h"
+#include <QHash>
+#include <QtAlgorithms>
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+namespace {
+
+constexpr int DeckSize = 52;
+constexpr int HandSize = 5;
+constexpr int Values = 13;
+constexpr int PairClasses = Values * Values;
+
+// Card index layout (Card::getIndex): value rank * 4 + suit
+inline int valueOf(int index) { return index / 4; }
+inline int suitOf(int index) { return index % 4; }
+
+// Pair class on the 13 x 13 grid: diagonal = pair, above = suited, below = offsuit
+inline int pairClass(int a, int b) {
+    int lo = std::min(valueOf(a), valueOf(b));
+    int hi = std::max(valueOf(a), valueOf(b));
+    return suitOf(a) == suitOf(b) ? lo * Values + hi : hi * Values + lo;
+}
+
+// The pair each class is counted on: lower value in suit 0, higher in suit 0 (suited) or 1
+inline bool isRepresentative(int a, int b) {
+    if (valueOf(a) > valueOf(b) || (valueOf(a) == valueOf(b) && suitOf(a) > suitOf(b)))
+        std::swap(a, b);
+    return suitOf(a) == 0 && (suitOf(b) == 1 || (suitOf(b) == 0 && valueOf(a) != valueOf(b)));
+}
+
+// Suit-canonical key of a card set: its per-suit value masks, largest first
+quint64 canonicalKey(const int* cards, int count) {
+    int masks[4] = {0};
+    for (int i = 0; i < count; ++i)
+        masks[suitOf(cards[i])] |= 1 << valueOf(cards[i]);
+    std::sort(masks, masks + 4, std::greater<int>());
+    return (quint64(masks[0]) << 39) | (quint64(masks[1]) << 26) | (quint64(masks[2]) << 13) | quint64(masks[3]);
+}
+
+// Three- or four-card sets up to suit renaming, each with the sorted strength
+// ranks of every hand that completes it (1,755 x 1,176 and 16,432 x 48 entries).
+// Every set's class is looked up directly by the set's colex number.
+struct SubsetClasses {
+    int completions = 0;
+    std::vector<quint16> classOf;               // [colex number of the set]: class
+    std::vector<quint16> completionRanks;       // [class][completion], ascending
+
+    // Count the completions of a set (by colex number) that are stronger than rank
+    int stronger(quint32 set, int rank) const {
+        const quint16* row = &completionRanks[size_t(classOf[set]) * completions];
+        return completions - int(std::upper_bound(row, row + completions, rank) - row);
+    }
+};
+
+struct Tables {
+    quint32 binomial[DeckSize + 1][HandSize + 1] = {};
+    std::vector<quint16> handRank;       // By colex number: strength rank, 0 = weakest
+    int ranks = 0;
+    std::vector<quint32> atLeast;        // [rank]: hands at least this strong (ranks + 1 entries)
+    std::vector<quint32> cardAtLeast;    // [value][rank]: of those, hands holding (value, suit 0)
+    std::vector<quint32> pairAtLeast;    // [pair class][rank]: of those, hands holding the class's pair
+    SubsetClasses triples;
+    SubsetClasses quads;
+
+    Tables() {
+        for (int n = 0; n <= DeckSize; ++n) {
+            binomial[n][0] = 1;
+            for (int k = 1; k <= HandSize && k <= n; ++k)
+                binomial[n][k] = binomial[n - 1][k - 1] + (k < n ? binomial[n - 1][k] : 0);
+        }
+
+        // Strength of every hand, then the distinct strengths in order
+        std::vector<quint32> strength(HandRanking::TotalHands);
+        int c[HandSize];
+        Card cards[HandSize];
+        for (c[4] = 4; c[4] < DeckSize; ++c[4])
+        for (c[3] = 3; c[3] < c[4]; ++c[3])
+        for (c[2] = 2; c[2] < c[3]; ++c[2])
+        for (c[1] = 1; c[1] < c[2]; ++c[1])
+        for (c[0] = 0; c[0] < c[1]; ++c[0]) {
+            for (int i = 0; i < HandSize; ++i)
+                cards[i] = Card::fromIndex(c[i]);
+            strength[colex(c)] = HandEvaluator::drawStrength(cards);
+        }
+        std::vector<quint32> keys = strength;
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        ranks = int(keys.size());
+
+        handRank.resize(HandRanking::TotalHands);
+        for (size_t h = 0; h < strength.size(); ++h)
+            handRank[h] = quint16(std::lower_bound(keys.begin(), keys.end(), strength[h]) - keys.begin());
+
+        // Exact counts per rank, then suffix sums
+        atLeast.assign(ranks + 1, 0);
+        cardAtLeast.assign(size_t(Values) * (ranks + 1), 0);
+        pairAtLeast.assign(size_t(PairClasses) * (ranks + 1), 0);
+        for (c[4] = 4; c[4] < DeckSize; ++c[4])
+        for (c[3] = 3; c[3] < c[4]; ++c[3])
+        for (c[2] = 2; c[2] < c[3]; ++c[2])
+        for (c[1] = 1; c[1] < c[2]; ++c[1])
+        for (c[0] = 0; c[0] < c[1]; ++c[0]) {
+            int rank = handRank[colex(c)];
+            atLeast[rank]++;
+            for (int i = 0; i < HandSize; ++i) {
+                if (suitOf(c[i]) == 0)
+                    cardAtLeast[size_t(valueOf(c[i])) * (ranks + 1) + rank]++;
+                for (int j = i + 1; j < HandSize; ++j) {
+                    if (isRepresentative(c[i], c[j]))
+                        pairAtLeast[size_t(pairClass(c[i], c[j])) * (ranks + 1) + rank]++;
+                }
+            }
+        }
+        suffixSums(atLeast.data(), 1);
+        suffixSums(cardAtLeast.data(), Values);
+        suffixSums(pairAtLeast.data(), PairClasses);
+
+        buildSubsets(triples, 3);
+        buildSubsets(quads, 4);
+    }
+
+    // Turn rows of per-rank counts into "at least this rank" counts
+    void suffixSums(quint32* rows, int count) const {
+        for (int row = 0; row < count; ++row) {
+            quint32* r = rows + size_t(row) * (ranks + 1);
+            for (int i = ranks - 1; i >= 0; --i)
+                r[i] += r[i + 1];
+        }
+    }
+
+    // Number the suit classes of size-card sets and rank the completions of one set per class
+    void buildSubsets(SubsetClasses& classes, int size) {
+        classes.completions = int(binomial[DeckSize - size][HandSize - size]);
+        classes.classOf.resize(binomial[DeckSize][size]);
+
+        QHash<quint64, int> ids;
+        int set[HandSize];
+        auto visit = [&](auto& self, int slot, int from) -> void {
+            if (slot == size) {
+                quint64 key = canonicalKey(set, size);
+                int known = ids.value(key, -1);
+                if (known >= 0) {
+                    classes.classOf[colex(set, size)] = quint16(known);
+                    return;
+                }
+                int id = ids.size();
+                ids.insert(key, id);
+                classes.classOf[colex(set, size)] = quint16(id);
+                size_t row = classes.completionRanks.size();
+                complete(set, size, size, 0, classes.completionRanks);
+                std::sort(classes.completionRanks.begin() + row, classes.completionRanks.end());
+                return;
+            }
+            for (int card = from; card < DeckSize; ++card) {
+                set[slot] = card;
+                self(self, slot + 1, card + 1);
+            }
+        };
+        visit(visit, 0, 0);
+    }
+
+    // Append the rank of every hand made by adding cards outside set[0..size) to it
+    void complete(int* set, int size, int slot, int from, std::vector<quint16>& out) const {
+        if (slot == HandSize) {
+            out.push_back(quint16(rankOf(set[0], set[1], set[2], set[3], set[4])));
+            return;
+        }
+        for (int card = from; card < DeckSize; ++card) {
+            if (std::find(set, set + size, card) != set + size)
+                continue;
+            set[slot] = card;
+            complete(set, size, slot + 1, card + 1, out);
+        }
+    }
+
+    // Colex number of count (default five) ascending card indices
+    quint32 colex(const int* sorted, int count = HandSize) const {
+        quint32 index = 0;
+        for (int i = 0; i < count; ++i)
+            index += binomial[sorted[i]][i + 1];
+        return index;
+    }
+
+    // Strength rank of five card indices in any order
+    int rankOf(int a, int b, int c, int d, int e) const {
+        int sorted[HandSize] = { a, b, c, d, e };
+        std::sort(sorted, sorted + HandSize);
+        return handRank[colex(sorted)];
+    }
+};
+
+const Tables& tables() {
+    static const Tables t;
+    return t;
+}
+
+} // namespace
+
+// Get the share of all hands below this one, ties counting half
+double HandRanking::Position::percentile() const {
+    return valid ? 100.0 * (weaker + (ties + 1) / 2.0) / TotalHands : 0.0;
+}
+
+// Build the tables now rather than on the first locate()
+void HandRanking::prepare() {
+    tables();
+}
+
+// Rank a hand with the opponent's five cards face up (both draw hands are shown)
+HandRanking::Position HandRanking::locate(const Hand& hand, const Hand& opponent) {
+    quint64 known = 0;
+    for (const Card& card : opponent.getCards()) {
+        if (!card.isJoker())
+            known |= quint64(1) << card.getIndex();
+    }
+    return locateWith(hand, known);
+}
+
+// Rank a hand with only its own cards visible
+HandRanking::Position HandRanking::locate(const Hand& hand) {
+    return locateWith(hand, 0);
+}
+
+// Rank a five-card hand and count the unseen opponent hands that beat it
+HandRanking::Position HandRanking::locateWith(const Hand& hand, quint64 knownCards) {
+    Position position;
+    const std::vector<Card>& cards = hand.getCards();
+    if (cards.size() != size_t(HandSize))
+        return position;
+
+    int own[HandSize];
+    quint64 ownMask = 0;
+    for (int i = 0; i < HandSize; ++i) {
+        if (cards[i].isJoker())
+            return position;
+        own[i] = cards[i].getIndex();
+        ownMask |= quint64(1) << own[i];
+    }
+    if (qPopulationCount(ownMask) != HandSize)
+        return position;  // The same card twice (multi-deck shoe)
+
+    const Tables& t = tables();
+    const int stride = t.ranks + 1;
+    int rank = t.rankOf(own[0], own[1], own[2], own[3], own[4]);
+    position.valid = true;
+    position.stronger = t.atLeast[rank + 1];
+    position.ties = t.atLeast[rank] - t.atLeast[rank + 1] - 1;
+    position.weaker = TotalHands - t.atLeast[rank];
+
+    // Visible cards: the hand itself plus whatever else is face up
+    int visible[DeckSize];
+    int seen = 0;
+    quint64 visibleMask = ownMask | (knownCards & ((quint64(1) << DeckSize) - 1));
+    for (int i = 0; i < DeckSize; ++i) {
+        if (visibleMask & (quint64(1) << i))
+            visible[seen++] = i;
+    }
+    position.possible = t.binomial[DeckSize - seen][HandSize];
+
+    // Inclusion-exclusion over the visible cards: the hands avoiding all of them
+    // = sum over visible subsets T of (-1)^|T| x (stronger hands containing T).
+    // Subsets come out in ascending order, so their colex numbers build up term
+    // by term and every term is a direct table lookup (at most 637 for 10 cards).
+    auto b = [&t](int card, int slot) { return t.binomial[card][slot]; };
+    qint64 beaten = t.atLeast[rank + 1];
+    for (int i = 0; i < seen; ++i) {
+        int a0 = visible[i];
+        beaten -= t.cardAtLeast[size_t(valueOf(a0)) * stride + rank + 1];
+        for (int j = i + 1; j < seen; ++j) {
+            int a1 = visible[j];
+            beaten += t.pairAtLeast[size_t(pairClass(a0, a1)) * stride + rank + 1];
+            quint32 c2 = b(a0, 1) + b(a1, 2);
+            for (int k = j + 1; k < seen; ++k) {
+                quint32 c3 = c2 + b(visible[k], 3);
+                beaten -= t.triples.stronger(c3, rank);
+                for (int l = k + 1; l < seen; ++l) {
+                    quint32 c4 = c3 + b(visible[l], 4);
+                    beaten += t.quads.stronger(c4, rank);
+                    for (int m = l + 1; m < seen; ++m)
+                        beaten -= t.handRank[c4 + b(visible[m], 5)] > rank ? 1 : 0;
+                }
+            }
+        }
+    }
+
+    position.beatenBy = quint64(beaten);
+    return position;
+}
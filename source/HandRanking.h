@@ -0,0 +1,45 @@
+#ifndef HANDRANKING_H
+#define HANDRANKING_H
+
+#include "Hand.h"
+#include <QtGlobal>
+
+// Where a five-card hand stands among all 2,598,960 hands of one deck, in
+// the order Game::compareHands uses.
+// Every hand is ranked once (by prepare() or on first use) into a strength-rank
+// table indexed by the hand's colex number, with suffix counts "hands at least
+// this strong" per rank. Counting the opponent hands that beat you from the
+// unseen cards is inclusion-exclusion over the visible cards: the single-card
+// and card-pair terms come from suffix tables keyed by card value (13) and by
+// pair class (169: pairs, suited and offsuit pairs of values), which suit
+// symmetry makes exact. The three- and four-card terms use the suit classes
+// of those sets (1,755 and 16,432), each holding the sorted ranks of its
+// completions, and five-card terms are single rank lookups. All are indexed
+// by colex number, so with the opponent's hand face up (10 visible cards, 637
+// terms, most of them binary searches) a query is bounded at roughly 20–50
+// microseconds. Call prepare() at startup: building the tables takes about a
+// second.
+class HandRanking {
+public:
+    static constexpr quint64 TotalHands = 2598960;
+
+    struct Position {
+        bool valid = false;        // False for jokers, duplicates or a hand that is not five cards
+        quint64 weaker = 0;        // Hands this one beats
+        quint64 ties = 0;          // Other hands of equal strength
+        quint64 stronger = 0;      // Hands that beat this one
+        quint64 beatenBy = 0;      // Opponent hands from the unseen cards that beat this one
+        quint64 possible = 0;      // Opponent hands from the unseen cards
+
+        double percentile() const; // Share of all hands below this one, ties counting half (0–100)
+    };
+
+    static void prepare();                                        // Build the tables now instead of on first use
+    static Position locate(const Hand& hand);                     // Only the hand's own cards visible
+    static Position locate(const Hand& hand, const Hand& opponent); // The opponent's hand face up as well
+
+private:
+    static Position locateWith(const Hand& hand, quint64 knownCards); // knownCards: other visible cards, bit Card::getIndex()
+};
+
+#endif // HANDRANKING_H
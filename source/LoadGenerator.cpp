@@ -0,0 +1,118 @@
+#include "LoadGenerator.h"
+#include "Protocol.h"
+#include "GameRules.h"
+#include <QRandomGenerator>
+#include <QtEndian>
+#include <QTextStream>
+#include <QTimer>
+#include <algorithm>
+
+// Constructor: remember the target and workload
+LoadGenerator::LoadGenerator(const QString& host, quint16 port, int players, int actionsPerPlayer, QObject *parent)
+    : QObject(parent), host(host), port(port), players(players), actionsPerPlayer(actionsPerPlayer) {
+    latencies.reserve(size_t(players) * actionsPerPlayer);
+}
+
+// Destructor: free all clients
+LoadGenerator::~LoadGenerator() {
+    qDeleteAll(clients);
+}
+
+// Connect every simulated player; each starts a game once connected
+void LoadGenerator::start() {
+    clock.start();
+
+    // Nothing to send: report at once (from the event loop, so finished() reaches a running app)
+    if (players <= 0 || actionsPerPlayer <= 0) {
+        QTimer::singleShot(0, this, [this]() {
+            report();
+            emit finished();
+        });
+        return;
+    }
+
+    for (int i = 0; i < players; ++i) {
+        Client* client = new Client;
+        client->socket = new QTcpSocket(this);
+        client->actionsLeft = actionsPerPlayer;
+        client->socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        clients.append(client);
+
+        connect(client->socket, &QTcpSocket::connected, this, [this, client]() { send(client, Protocol::Start); });
+        connect(client->socket, &QTcpSocket::readyRead, this, [this, client]() { onResponse(client); });
+        connect(client->socket, &QTcpSocket::errorOccurred, this, [this, client]() { clientDone(client); });
+        client->socket->connectToHost(host, port);
+    }
+}
+
+// Send one action and start its latency clock
+void LoadGenerator::send(Client* client, quint8 opcode, quint8 mask) {
+    char request[Protocol::RequestSize] = { char(opcode), char(mask) };
+    client->sentAt = clock.nsecsElapsed();
+    client->socket->write(request, Protocol::RequestSize);
+}
+
+// Record the latency of each response and pick the next action
+void LoadGenerator::onResponse(Client* client) {
+    QTcpSocket* socket = client->socket;
+    while (socket->bytesAvailable() >= Protocol::ResponseSize) {
+        char response[Protocol::ResponseSize];
+        socket->read(response, Protocol::ResponseSize);
+        latencies.push_back(clock.nsecsElapsed() - client->sentAt);
+
+        if (--client->actionsLeft <= 0) {
+            clientDone(client);
+            return;
+        }
+
+        quint8 opcode = quint8(response[0]);
+        quint8 status = quint8(response[1]);
+        quint32 round = qFromLittleEndian<quint32>(reinterpret_cast<const uchar*>(response) + 2);
+
+        if (status == Protocol::GameOver) {
+            send(client, Protocol::Start);
+        } else if (opcode != Protocol::Swap && status == Protocol::Ok && round <= quint32(StandardRules::SwapRounds)) {
+            // Swap one card up to the swap limit, chosen at random, like a player would
+            quint8 mask = 0;
+            int count = QRandomGenerator::global()->bounded(1, StandardRules::SwapLimit + 1);
+            while (int(qPopulationCount(mask)) < count)
+                mask |= 1 << QRandomGenerator::global()->bounded(StandardRules::HandSize);
+            send(client, Protocol::Swap, mask);
+        } else {
+            send(client, Protocol::Deal);
+        }
+    }
+}
+
+// Close a finished (or failed) player and report once all are done
+void LoadGenerator::clientDone(Client* client) {
+    if (client->done)
+        return;  // Already counted
+    client->done = true;
+    client->socket->disconnectFromHost();
+
+    if (++donePlayers == players) {
+        report();
+        emit finished();
+    }
+}
+
+// Print throughput and latency percentiles
+void LoadGenerator::report() {
+    QTextStream out(stdout);
+    double seconds = clock.nsecsElapsed() / 1e9;
+    out << "Players: " << players << ", actions: " << latencies.size()
+        << ", time: " << QString::number(seconds, 'f', 2) << " s, throughput: "
+        << QString::number(latencies.size() / seconds, 'f', 0) << " actions/s\n";
+
+    if (latencies.empty())
+        return;
+
+    auto percentile = [this](double p) {
+        size_t k = std::min(latencies.size() - 1, size_t(p * latencies.size()));
+        std::nth_element(latencies.begin(), latencies.begin() + k, latencies.end());
+        return latencies[k] / 1000.0;
+    };
+    out << "Latency p50: " << QString::number(percentile(0.50), 'f', 1) << " us, p99: "
+        << QString::number(percentile(0.99), 'f', 1) << " us" << Qt::endl;
+}
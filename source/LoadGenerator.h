@@ -0,0 +1,49 @@
+#ifndef LOADGENERATOR_H
+#define LOADGENERATOR_H
+
+#include <QObject>
+#include <QTcpSocket>
+#include <QElapsedTimer>
+#include <QVector>
+#include <vector>
+
+// Simulates many players against a PokerServer from one thread.
+// Each simulated player keeps one action in flight (start, swap or deal), and the
+// time from sending an action to receiving its response is recorded. When every
+// player has finished, p50/p99 latency and throughput are printed.
+class LoadGenerator : public QObject {
+    Q_OBJECT
+
+public:
+    LoadGenerator(const QString& host, quint16 port, int players, int actionsPerPlayer, QObject *parent = nullptr);
+    ~LoadGenerator();
+
+    void start();                                 // Connect all players
+
+signals:
+    void finished();                              // All players are done
+
+private:
+    struct Client {
+        QTcpSocket* socket = nullptr;
+        qint64 sentAt = 0;                        // Clock time of the action in flight (ns)
+        int actionsLeft = 0;
+        bool done = false;                        // Finished or failed, and counted in donePlayers
+    };
+
+    QString host;
+    quint16 port;
+    int players;
+    int actionsPerPlayer;
+    QVector<Client*> clients;
+    std::vector<qint64> latencies;                // One entry per answered action (ns)
+    QElapsedTimer clock;
+    int donePlayers = 0;
+
+    void send(Client* client, quint8 opcode, quint8 mask = 0);
+    void onResponse(Client* client);
+    void clientDone(Client* client);
+    void report();
+};
+
+#endif // LOADGENERATOR_H
@@ -0,0 +1,79 @@
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include "Game.h"
+#include "HandRanking.h"
+#include <QtGlobal>
+#include <QByteArray>
+#include <QtEndian>
+
+// Binary protocol between PokerServer and its clients.
+// Request  (2 bytes):  [opcode][swap mask: bit i = swap card i]
+// Response (39 bytes): [opcode][status][round: 4][result][player score: 4][computer score: 4]
+//                      [player category][computer category][5 player cards][5 computer cards]
+//                      [player percentile: 2][computer percentile: 2]
+//                      [player beaten by: 4][computer beaten by: 4]
+// Cards are sent as Card::getIndex(); categories as Hand::getRankIndex().
+// The round and scores are little-endian 32-bit, since a shoe game can run
+// past 255 rounds.
+// Percentiles (hundredths, 0xFFFF = not ranked) and beaten-by counts (hands
+// from the 42 cards neither seat holds that beat the seat's hand) are
+// little-endian; both come from HandRanking, exactly as the table view shows
+// them. They are only filled in when the server ranks hands (off by default,
+// see GameServer::setRanking) and only for five-card draw hands.
+namespace Protocol {
+
+enum Opcode : quint8 {
+    Start = 1,      // Start a new game and deal the first round
+    Deal = 2,       // Deal the next round
+    Swap = 3        // Swap the cards in the mask (up to 3)
+};
+
+enum Status : quint8 {
+    Ok = 0,
+    GameOver = 1,   // Deck exhausted: send Start to play again
+    Rejected = 2    // Swap not allowed or unknown opcode
+};
+
+enum Result : quint8 {
+    Draw = 0,
+    PlayerWins = 1,
+    ComputerWins = 2
+};
+
+constexpr int RequestSize = 2;
+constexpr int ResponseSize = 39;
+
+// Build the response describing the game's current round; ranks (one per seat) may be null
+inline QByteArray encodeResponse(quint8 opcode, quint8 status, Game& game, const HandRanking::Position* ranks) {
+    QByteArray out(ResponseSize, 0);
+    uchar* data = reinterpret_cast<uchar*>(out.data());
+    const Player* winner = game.winnerOfRound();
+    out[0] = char(opcode);
+    out[1] = char(status);
+    qToLittleEndian(quint32(game.currentRound()), data + 2);
+    out[6] = char(winner == nullptr ? Draw : winner == &game.getPlayer() ? PlayerWins : ComputerWins);
+    qToLittleEndian(quint32(game.getPlayer().getScore()), data + 7);
+    qToLittleEndian(quint32(game.getComputer().getScore()), data + 11);
+    out[15] = char(game.getPlayer().getHand().getRankIndex());
+    out[16] = char(game.getComputer().getHand().getRankIndex());
+
+    const auto& playerCards = game.getPlayer().getHand().getCards();
+    const auto& computerCards = game.getComputer().getHand().getCards();
+    for (size_t i = 0; i < 5; ++i) {
+        out[17 + i] = char(i < playerCards.size() ? playerCards[i].getIndex() : 0xFF);
+        out[22 + i] = char(i < computerCards.size() ? computerCards[i].getIndex() : 0xFF);
+    }
+
+    for (int seat = 0; seat < 2; ++seat) {
+        HandRanking::Position position = ranks ? ranks[seat] : HandRanking::Position();
+        quint16 percentile = position.valid ? quint16(position.percentile() * 100.0 + 0.5) : 0xFFFF;
+        qToLittleEndian(percentile, data + 27 + 2 * seat);
+        qToLittleEndian(quint32(position.beatenBy), data + 31 + 4 * seat);
+    }
+    return out;
+}
+
+} // namespace Protocol
+
+#endif // PROTOCOL_H
@@ -0,0 +1,73 @@
+#include "RoundStream.h"
+
+// Constructor: stream count rounds from game
+RoundStream::RoundStream(Game& game, quint64 count, SwapPolicy policy)
+    : game(game), remaining(count), policy(std::move(policy)) {}
+
+// Play one round and describe it in record
+bool RoundStream::next(RoundRecord& record) {
+    if (remaining == 0)
+        return false;
+
+    if (!game.dealNextRound()) {
+        game.startGame();
+        if (!game.dealNextRound())
+            return false;
+    }
+
+    record.playerSwapMask = 0;
+    record.computerSwapMask = 0;
+    if (policy) {
+        quint8 mask = policy(game.getPlayer().getHand());
+        swapIndices.clear();
+        for (int i = 0; i < 8; ++i) {
+            if (mask & (1 << i))
+                swapIndices.append(i);
+        }
+        if (!swapIndices.isEmpty() && game.playerSwapCards(swapIndices)) {
+            record.playerSwapMask = game.lastPlayerSwap();
+            if (game.lastComputerSwap() >= 0)
+                record.computerSwapMask = 1 << game.lastComputerSwap();
+        }
+    }
+
+    const auto& playerCards = game.getPlayer().getHand().getCards();
+    const auto& computerCards = game.getComputer().getHand().getCards();
+    for (size_t i = 0; i < size_t(RoundRecord::MaxCards); ++i) {
+        record.playerCards[i] = i < playerCards.size() ? playerCards[i].getIndex() : 0xFF;
+        record.computerCards[i] = i < computerCards.size() ? computerCards[i].getIndex() : 0xFF;
+    }
+
+    const Player* winner = game.winnerOfRound();
+    record.sequence = produced++;
+    record.round = game.currentRound();
+    record.playerCategory = game.getPlayer().getHand().getRankIndex();
+    record.computerCategory = game.getComputer().getHand().getRankIndex();
+    record.result = winner == nullptr ? 0 : winner == &game.getPlayer() ? 1 : -1;
+
+    --remaining;
+    return true;
+}
+
+// Iterator positioned on the first round (or end if the stream is empty)
+RoundStream::iterator RoundStream::begin() {
+    return iterator(this);
+}
+
+// End-of-stream iterator
+RoundStream::iterator RoundStream::end() {
+    return iterator();
+}
+
+// Pull the first record
+RoundStream::iterator::iterator(RoundStream* stream) : stream(stream) {
+    if (!stream->next(record))
+        this->stream = nullptr;
+}
+
+// Pull the next record, becoming the end iterator when the stream is done
+RoundStream::iterator& RoundStream::iterator::operator++() {
+    if (stream && !stream->next(record))
+        stream = nullptr;
+    return *this;
+}
@@ -0,0 +1,74 @@
+#ifndef ROUNDSTREAM_H
+#define ROUNDSTREAM_H
+
+#include "Game.h"
+#include <QtGlobal>
+#include <QVector>
+#include <functional>
+#include <iterator>
+
+// Compact record of one finished round (cards as Card::getIndex(), 0xFF = no card)
+struct RoundRecord {
+    static constexpr int MaxCards = 7;      // Five for draw; two hole cards then the five board cards for Hold'em
+
+    quint64 sequence = 0;          // Position in the stream (0-based)
+    quint32 round = 0;             // Round number within its game (a shoe game can run long)
+    quint8 playerCards[MaxCards] = {};
+    quint8 computerCards[MaxCards] = {};
+    quint8 playerSwapMask = 0;     // Bit i = player's card i was replaced (the swap the game accepted)
+    quint8 computerSwapMask = 0;   // Bit i = computer swapped card i
+    quint8 playerCategory = 0;     // Hand::getRankIndex()
+    quint8 computerCategory = 0;
+    qint8 result = 0;              // 1 = player wins, -1 = computer wins, 0 = draw
+};
+
+// Lazy stream of rounds played on a Game.
+// Each pull deals (starting a new game when the deck runs out), applies the
+// optional player swap policy, and fills a single RoundRecord in place, so a
+// pipeline reading the stream runs in constant memory however many rounds it asks for:
+//
+//     RoundStream stream(game, 1000000);
+//     for (const RoundRecord& r : stream)
+//         if (r.playerSwapMask) writer.write(r);
+class RoundStream {
+public:
+    using SwapPolicy = std::function<quint8(const Hand&)>; // Cards the player swaps (bit i = card i, 0 = stand)
+
+    RoundStream(Game& game, quint64 count, SwapPolicy policy = SwapPolicy());
+
+    bool next(RoundRecord& record);                // Produce the next round (false when done)
+
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = RoundRecord;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const RoundRecord*;
+        using reference = const RoundRecord&;
+
+        iterator() = default;
+        explicit iterator(RoundStream* stream);
+
+        reference operator*() const { return record; }
+        pointer operator->() const { return &record; }
+        iterator& operator++();
+        bool operator==(const iterator& other) const { return stream == other.stream; }
+        bool operator!=(const iterator& other) const { return stream != other.stream; }
+
+    private:
+        RoundStream* stream = nullptr;             // nullptr = end of stream
+        RoundRecord record;
+    };
+
+    iterator begin();                              // Pulls the first round
+    iterator end();
+
+private:
+    Game& game;
+    quint64 remaining;
+    quint64 produced = 0;
+    SwapPolicy policy;
+    QVector<int> swapIndices;                      // Reused for Game::playerSwapCards, so pulls do not allocate
+};
+
+#endif // ROUNDSTREAM_H
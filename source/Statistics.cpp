@@ -0,0 +1,70 @@
+#include "Statistics.h"
+
+// Get the process-wide statistics object
+Statistics& Statistics::instance() {
+    static Statistics stats;
+    return stats;
+}
+
+// Get this thread's counter block, registering it on first use.
+// Blocks are never freed so counts from finished threads stay visible.
+Statistics::Block& Statistics::localBlock() {
+    thread_local Block* block = nullptr;
+    if (!block) {
+        block = new Block();
+        Block* expected = head.load(std::memory_order_relaxed);
+        do {
+            block->next = expected;
+        } while (!head.compare_exchange_weak(expected, block,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed));
+    }
+    return *block;
+}
+
+// Increment a counter owned by the calling thread (no read-modify-write needed)
+void Statistics::bump(std::atomic<quint64>& counter) {
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+// Record the final categories and outcome of a round
+void Statistics::recordRound(int category0, int category1, Outcome outcome) {
+    if (category0 < 0 || category0 >= Categories || category1 < 0 || category1 >= Categories)
+        return;
+
+    Block& block = localBlock();
+    bump(block.rounds);
+    bump(block.categories[0][category0]);
+    bump(block.categories[1][category1]);
+    bump(block.matchups[category0][category1][outcome]);
+}
+
+// Record a swap and whether it improved the seat's hand
+void Statistics::recordSwap(int seat, bool improved) {
+    if (seat < 0 || seat >= Seats)
+        return;
+
+    Block& block = localBlock();
+    bump(block.swaps[seat]);
+    if (improved)
+        bump(block.improvingSwaps[seat]);
+}
+
+// Sum the counters of every thread that has recorded anything
+Statistics::Snapshot Statistics::snapshot() const {
+    Snapshot total;
+    for (const Block* block = head.load(std::memory_order_acquire); block; block = block->next) {
+        total.rounds += block->rounds.load(std::memory_order_relaxed);
+        for (int s = 0; s < Seats; ++s) {
+            for (int c = 0; c < Categories; ++c)
+                total.categories[s][c] += block->categories[s][c].load(std::memory_order_relaxed);
+            total.swaps[s] += block->swaps[s].load(std::memory_order_relaxed);
+            total.improvingSwaps[s] += block->improvingSwaps[s].load(std::memory_order_relaxed);
+        }
+        for (int a = 0; a < Categories; ++a)
+            for (int b = 0; b < Categories; ++b)
+                for (int o = 0; o < OutcomeCount; ++o)
+                    total.matchups[a][b][o] += block->matchups[a][b][o].load(std::memory_order_relaxed);
+    }
+    return total;
+}
@@ -0,0 +1,49 @@
+#ifndef STATISTICS_H
+#define STATISTICS_H
+
+#include "Hand.h"
+#include <QtGlobal>
+#include <atomic>
+
+// Running statistics over every round played in the process.
+// Each thread writes to its own counter block, so recording never takes a
+// lock or contends on a cache line; snapshot() sums all blocks on read.
+class Statistics {
+public:
+    static constexpr int Seats = 2;                      // 0 = player, 1 = computer
+    static constexpr int Categories = Hand::CategoryCount;
+
+    enum Outcome { Win, Draw, Loss, OutcomeCount };      // Outcome from seat 0's point of view
+
+    struct Snapshot {
+        quint64 rounds = 0;
+        quint64 categories[Seats][Categories] = {};             // Final category frequency per seat
+        quint64 matchups[Categories][Categories][OutcomeCount] = {}; // [seat 0 category][seat 1 category][outcome]
+        quint64 swaps[Seats] = {};                               // Swaps made per seat
+        quint64 improvingSwaps[Seats] = {};                      // Swaps that produced a stronger hand
+    };
+
+    static Statistics& instance();                       // Process-wide statistics
+
+    void recordRound(int category0, int category1, Outcome outcome); // Record a finished round
+    void recordSwap(int seat, bool improved);            // Record one swap for a seat
+    Snapshot snapshot() const;                           // Merge all thread blocks
+
+private:
+    struct Block {
+        std::atomic<quint64> rounds;
+        std::atomic<quint64> categories[Seats][Categories];
+        std::atomic<quint64> matchups[Categories][Categories][OutcomeCount];
+        std::atomic<quint64> swaps[Seats];
+        std::atomic<quint64> improvingSwaps[Seats];
+        Block* next = nullptr;
+    };
+
+    Statistics() = default;
+    Block& localBlock();                                 // Get (or register) this thread's block
+    static void bump(std::atomic<quint64>& counter);     // Single-writer increment
+
+    std::atomic<Block*> head{nullptr};                   // Lock-free list of all thread blocks
+};
+
+#endif // STATISTICS_H
@@ -0,0 +1,96 @@
+#include "StrategyTable.h"
+#include "HandAbstraction.h"
+#include <QDataStream>
+#include <QFile>
+#include <QRandomGenerator>
+#include <QSaveFile>
+#include <cmath>
+
+// Load a strategy table from disk
+bool StrategyTable::load(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    quint32 magic, version, classes, observations, actions;
+    in >> magic >> version >> classes >> observations >> actions;
+    if (magic != Magic || version != Version || int(classes) != HandAbstraction::classCount()
+        || observations != Observations || actions != Actions)
+        return false;
+
+    std::vector<quint8> table(size_t(classes) * Observations * Actions);
+    if (in.readRawData(reinterpret_cast<char*>(table.data()), int(table.size())) != int(table.size()))
+        return false;
+
+    weights.swap(table);
+    return true;
+}
+
+// Save the strategy table (replaces the file only once fully written)
+bool StrategyTable::save(const QString& path) const {
+    QSaveFile file(path);
+    if (!isLoaded() || !file.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream out(&file);
+    out << Magic << Version << quint32(HandAbstraction::Classes) << quint32(Observations) << quint32(Actions);
+    out.writeRawData(reinterpret_cast<const char*>(weights.data()), int(weights.size()));
+    return out.status() == QDataStream::Ok && file.commit();
+}
+
+// Check if a table is present
+bool StrategyTable::isLoaded() const {
+    return !weights.empty();
+}
+
+// Quantize one row of probabilities so the bytes sum to 255
+void StrategyTable::setRow(int handClass, int playerSwaps, const double probabilities[Actions]) {
+    if (weights.empty())
+        weights.assign(size_t(HandAbstraction::Classes) * Observations * Actions, 0);
+
+    quint8* out = &weights[row(handClass, playerSwaps)];
+    int total = 0;
+    int largest = 0;
+    for (int a = 0; a < Actions; ++a) {
+        out[a] = quint8(std::lround(probabilities[a] * 255));
+        total += out[a];
+        if (out[a] > out[largest])
+            largest = a;
+    }
+    if (total > 0)
+        out[largest] = quint8(out[largest] + 255 - total);  // Rounding slack goes to the likeliest action
+}
+
+// Sample the computer's reply for its hand after the player swapped playerSwaps cards
+bool StrategyTable::chooseSwap(const Hand& hand, int playerSwaps, int& swapIndex) const {
+    const std::vector<Card>& cards = hand.getCards();
+    if (!isLoaded() || playerSwaps < 1 || playerSwaps > Observations
+        || cards.size() != size_t(HandAbstraction::HandSize))
+        return false;
+
+    int order[HandAbstraction::HandSize];
+    int handClass = HandAbstraction::classOf(cards.data(), order);
+    if (handClass < 0)
+        return false;
+
+    const quint8* weight = &weights[row(handClass, playerSwaps)];
+    int total = 0;
+    for (int a = 0; a < Actions; ++a)
+        total += weight[a];
+    if (total == 0)
+        return false;  // Never reached while solving
+
+    int pick = QRandomGenerator::global()->bounded(total);
+    int action = 0;
+    while (pick >= weight[action])
+        pick -= weight[action++];
+
+    swapIndex = action == 0 ? -1 : order[action - 1];
+    return true;
+}
+
+// Get the offset of a row
+size_t StrategyTable::row(int handClass, int playerSwaps) {
+    return (size_t(handClass) * Observations + (playerSwaps - 1)) * Actions;
+}
@@ -0,0 +1,34 @@
+#ifndef STRATEGYTABLE_H
+#define STRATEGYTABLE_H
+
+#include "Hand.h"
+#include <QString>
+#include <QtGlobal>
+#include <vector>
+
+// Computer swap strategy solved offline by SwapSolver.
+// One row per (HandAbstraction class, number of cards the player swapped),
+// holding the probabilities of standing or swapping each of the five cards
+// in canonical order, quantized to bytes that sum to 255 (about 2.4 MB in all).
+class StrategyTable {
+public:
+    static constexpr int Observations = 3;         // The player swapped 1, 2 or 3 cards
+    static constexpr int Actions = 6;              // 0 = stand, 1 + p = swap canonical card p
+
+    bool load(const QString& path);                // Load a table written by save() (false if missing or invalid)
+    bool save(const QString& path) const;          // Write the table atomically
+    bool isLoaded() const;                         // Check if a table is present
+
+    void setRow(int handClass, int playerSwaps, const double probabilities[Actions]); // Fill one row
+    bool chooseSwap(const Hand& hand, int playerSwaps, int& swapIndex) const; // Sample a reply: hand index or -1 (false if no row applies)
+
+private:
+    static constexpr quint32 Magic = 0x504b5354;   // "PKST"
+    static constexpr quint32 Version = 1;
+
+    std::vector<quint8> weights;                   // Classes x Observations x Actions
+
+    static size_t row(int handClass, int playerSwaps); // Offset of a row in weights
+};
+
+#endif // STRATEGYTABLE_H
@@ -0,0 +1,346 @@
+#include "SwapSolver.h"
+#include "HandEvaluator.h"
+#include <QDataStream>
+#include <QFile>
+#include <QRandomGenerator>
+#include <QSaveFile>
+#include <QtAlgorithms>
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int DeckSize = 52;
+constexpr int HandSize = HandAbstraction::HandSize;
+constexpr int Dealt = 2 * HandSize;
+constexpr int MaxSwaps = 3;
+constexpr int PlayerRowSize = SwapSolver::PlayerActions;
+constexpr int ComputerRowSize = SwapSolver::ComputerActions;
+
+// Player actions as masks of canonical card positions, fewest cards first
+struct ActionMasks {
+    int mask[SwapSolver::PlayerActions];
+
+    ActionMasks() {
+        int next = 0;
+        for (int swaps = 0; swaps <= MaxSwaps; ++swaps) {
+            for (int m = 0; m < (1 << HandSize); ++m) {
+                if (int(qPopulationCount(quint32(m))) == swaps)
+                    mask[next++] = m;
+            }
+        }
+    }
+};
+
+const ActionMasks actionMasks;
+
+// Current strategy of one information set by regret matching
+template <int N>
+void regretMatch(const std::atomic<qint32>* regrets, double strategy[N]) {
+    double total = 0;
+    for (int a = 0; a < N; ++a) {
+        strategy[a] = regrets[a].load(std::memory_order_relaxed);
+        total += strategy[a];
+    }
+    for (int a = 0; a < N; ++a)
+        strategy[a] = total > 0 ? strategy[a] / total : 1.0 / N;
+}
+
+// Showdown from the player's point of view: 1 win, 0 draw, -1 loss
+int showdown(const Card* player, const Card* computer) {
+    quint32 a = HandEvaluator::drawStrength(player);
+    quint32 b = HandEvaluator::drawStrength(computer);
+    return a > b ? 1 : (a < b ? -1 : 0);
+}
+
+} // namespace
+
+// Per-thread traversal state: random source, the shuffled deck and a value tally
+struct SwapSolver::Worker {
+    QRandomGenerator rng;
+    int deck[DeckSize];
+    Card player[HandSize];
+    Card computer[HandSize];
+    int playerOrder[HandSize];
+    int computerOrder[HandSize];
+    int playerClass = 0;
+    int computerClass = 0;
+    double valueSum = 0;
+    quint64 valueCount = 0;
+
+    explicit Worker(quint32 seed) : rng(seed) {
+        for (int i = 0; i < DeckSize; ++i)
+            deck[i] = i;
+    }
+
+    // Shuffle the cards this iteration can reach to the front and deal both hands
+    void deal() {
+        for (int i = 0; i < Dealt + MaxSwaps; ++i)
+            std::swap(deck[i], deck[i + rng.bounded(DeckSize - i)]);
+        for (int i = 0; i < HandSize; ++i) {
+            player[i] = Card::fromIndex(deck[i]);
+            computer[i] = Card::fromIndex(deck[HandSize + i]);
+        }
+        playerClass = HandAbstraction::classOf(player, playerOrder);
+        computerClass = HandAbstraction::classOf(computer, computerOrder);
+    }
+
+    // Apply a player action; the replacements are the next cards of the deck
+    int swapPlayer(int action, Card* hand) const {
+        int mask = actionMasks.mask[action];
+        int next = Dealt;
+        std::copy(player, player + HandSize, hand);
+        for (int p = 0; p < HandSize; ++p) {
+            if (mask & (1 << p))
+                hand[playerOrder[p]] = Card::fromIndex(deck[next++]);
+        }
+        return next - Dealt;
+    }
+
+    // Draw the computer's replacement: any card in neither hand, including the player's discards
+    Card drawForComputer(int action) {
+        int mask = actionMasks.mask[action];
+        int swaps = qPopulationCount(quint32(mask));
+        int pick = rng.bounded(DeckSize - Dealt);
+        if (pick >= swaps)
+            return Card::fromIndex(deck[Dealt + pick]);
+        for (int p = 0; p < HandSize; ++p) {
+            if ((mask & (1 << p)) && pick-- == 0)
+                return player[playerOrder[p]];
+        }
+        return Card();
+    }
+
+    // Sample an action index from a strategy
+    template <int N>
+    int sample(const double strategy[N]) {
+        double r = rng.generateDouble();
+        for (int a = 0; a < N - 1; ++a) {
+            r -= strategy[a];
+            if (r < 0)
+                return a;
+        }
+        return N - 1;
+    }
+};
+
+// Constructor: allocate zeroed regret and strategy rows
+SwapSolver::SwapSolver(int threads)
+    : threads(std::max(1, threads)),
+      playerRegrets(new std::atomic<qint32>[size_t(Classes) * PlayerRowSize]()),
+      computerRegrets(new std::atomic<qint32>[size_t(Classes) * Observations * ComputerRowSize]()),
+      computerCounts(new std::atomic<quint32>[size_t(Classes) * Observations * ComputerRowSize]()) {}
+
+// Run iterations split over the worker threads, alternating the updated seat
+void SwapSolver::run(quint64 count) {
+    std::vector<Worker> workers;
+    workers.reserve(threads);
+    for (int t = 0; t < threads; ++t)
+        workers.emplace_back(QRandomGenerator::global()->generate());
+
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) {
+        quint64 share = count / threads + (quint64(t) < count % threads ? 1 : 0);
+        pool.emplace_back([this, &worker = workers[t], share, parity = completed + t]() {
+            for (quint64 i = 0; i < share; ++i) {
+                if ((parity + i) % 2 == 0)
+                    traversePlayer(worker);
+                else
+                    traverseComputer(worker);
+            }
+        });
+    }
+    for (auto& thread : pool)
+        thread.join();
+
+    double valueSum = 0;
+    quint64 valueCount = 0;
+    for (const Worker& worker : workers) {
+        valueSum += worker.valueSum;
+        valueCount += worker.valueCount;
+    }
+    lastValue = valueCount ? valueSum / valueCount : 0;
+    completed += count;
+}
+
+// Player update: every player action is tried, the computer's reply and all cards are sampled
+void SwapSolver::traversePlayer(Worker& worker) {
+    worker.deal();
+    std::atomic<qint32>* regrets = &playerRegrets[size_t(worker.playerClass) * PlayerRowSize];
+    double strategy[PlayerActions];
+    regretMatch<PlayerActions>(regrets, strategy);
+
+    double utility[PlayerActions];
+    double value = 0;
+    Card player[HandSize];
+    Card computer[HandSize];
+    for (int a = 0; a < PlayerActions; ++a) {
+        int swaps = worker.swapPlayer(a, player);
+        std::copy(worker.computer, worker.computer + HandSize, computer);
+
+        // The computer only gets to reply after a swap
+        if (swaps > 0) {
+            size_t row = computerRow(worker.computerClass, swaps);
+            double reply[ComputerActions];
+            regretMatch<ComputerActions>(&computerRegrets[row], reply);
+            int c = worker.sample<ComputerActions>(reply);
+            computerCounts[row + c].fetch_add(1, std::memory_order_relaxed);
+            if (c > 0)
+                computer[worker.computerOrder[c - 1]] = worker.drawForComputer(a);
+        }
+
+        utility[a] = showdown(player, computer);
+        value += strategy[a] * utility[a];
+    }
+
+    for (int a = 0; a < PlayerActions; ++a)
+        addRegret(regrets[a], utility[a] - value);
+    worker.valueSum += value;
+    ++worker.valueCount;
+}
+
+// Computer update: the player's action and all cards are sampled, every reply is tried
+void SwapSolver::traverseComputer(Worker& worker) {
+    worker.deal();
+    double strategy[PlayerActions];
+    regretMatch<PlayerActions>(&playerRegrets[size_t(worker.playerClass) * PlayerRowSize], strategy);
+    int action = worker.sample<PlayerActions>(strategy);
+
+    Card player[HandSize];
+    int swaps = worker.swapPlayer(action, player);
+    if (swaps == 0)
+        return;  // Nothing for the computer to decide
+
+    std::atomic<qint32>* regrets = &computerRegrets[computerRow(worker.computerClass, swaps)];
+    double reply[ComputerActions];
+    regretMatch<ComputerActions>(regrets, reply);
+
+    Card drawn = worker.drawForComputer(action);
+    double utility[ComputerActions];
+    double value = 0;
+    Card computer[HandSize];
+    for (int c = 0; c < ComputerActions; ++c) {
+        std::copy(worker.computer, worker.computer + HandSize, computer);
+        if (c > 0)
+            computer[worker.computerOrder[c - 1]] = drawn;
+        utility[c] = -showdown(player, computer);
+        value += reply[c] * utility[c];
+    }
+
+    for (int c = 0; c < ComputerActions; ++c)
+        addRegret(regrets[c], utility[c] - value);
+}
+
+// Regret-matching+ update: add in fixed point, floor at zero, saturate at the cap
+void SwapSolver::addRegret(std::atomic<qint32>& regret, double delta) {
+    qint64 updated = qint64(regret.load(std::memory_order_relaxed)) + std::lround(delta * RegretScale);
+    regret.store(qint32(std::clamp<qint64>(updated, 0, RegretCap)), std::memory_order_relaxed);
+}
+
+// Get the offset of a computer row
+size_t SwapSolver::computerRow(int handClass, int playerSwaps) {
+    return (size_t(handClass) * Observations + (playerSwaps - 1)) * ComputerRowSize;
+}
+
+// Get the number of iterations completed
+quint64 SwapSolver::iterations() const {
+    return completed;
+}
+
+// Get the player's mean utility during the last run
+double SwapSolver::playerValue() const {
+    return lastValue;
+}
+
+namespace {
+
+// Write an atomic array as raw native-endian values
+template <typename T>
+void writeArray(QDataStream& out, const std::atomic<T>* values, size_t count) {
+    std::vector<T> chunk;
+    for (size_t start = 0; start < count; start += 1 << 16) {
+        size_t n = std::min<size_t>(1 << 16, count - start);
+        chunk.resize(n);
+        for (size_t i = 0; i < n; ++i)
+            chunk[i] = values[start + i].load(std::memory_order_relaxed);
+        out.writeRawData(reinterpret_cast<const char*>(chunk.data()), int(n * sizeof(T)));
+    }
+}
+
+// Read an array written by writeArray into atomics
+template <typename T>
+bool readArray(QDataStream& in, std::atomic<T>* values, size_t count) {
+    std::vector<T> chunk;
+    for (size_t start = 0; start < count; start += 1 << 16) {
+        size_t n = std::min<size_t>(1 << 16, count - start);
+        chunk.resize(n);
+        int bytes = int(n * sizeof(T));
+        if (in.readRawData(reinterpret_cast<char*>(chunk.data()), bytes) != bytes)
+            return false;
+        for (size_t i = 0; i < n; ++i)
+            values[start + i].store(chunk[i], std::memory_order_relaxed);
+    }
+    return true;
+}
+
+} // namespace
+
+// Save regrets, strategy sums and the iteration count (replaces the file only once fully written)
+bool SwapSolver::saveCheckpoint(const QString& path) const {
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream out(&file);
+    out << Magic << Version << quint32(Classes) << completed;
+    writeArray(out, playerRegrets.get(), size_t(Classes) * PlayerRowSize);
+    writeArray(out, computerRegrets.get(), size_t(Classes) * Observations * ComputerRowSize);
+    writeArray(out, computerCounts.get(), size_t(Classes) * Observations * ComputerRowSize);
+    return out.status() == QDataStream::Ok && file.commit();
+}
+
+// Resume from a checkpoint written by saveCheckpoint
+bool SwapSolver::loadCheckpoint(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    quint32 magic, version, classes;
+    quint64 done;
+    in >> magic >> version >> classes >> done;
+    if (magic != Magic || version != Version || classes != quint32(Classes))
+        return false;
+
+    if (!readArray(in, playerRegrets.get(), size_t(Classes) * PlayerRowSize)
+        || !readArray(in, computerRegrets.get(), size_t(Classes) * Observations * ComputerRowSize)
+        || !readArray(in, computerCounts.get(), size_t(Classes) * Observations * ComputerRowSize))
+        return false;
+
+    completed = done;
+    return true;
+}
+
+// Normalize the sampled computer actions into the average strategy
+StrategyTable SwapSolver::computerStrategy() const {
+    StrategyTable table;
+    for (int handClass = 0; handClass < Classes; ++handClass) {
+        for (int swaps = 1; swaps <= Observations; ++swaps) {
+            const std::atomic<quint32>* row = &computerCounts[computerRow(handClass, swaps)];
+            double total = 0;
+            double probabilities[ComputerActions];
+            for (int c = 0; c < ComputerActions; ++c) {
+                probabilities[c] = row[c].load(std::memory_order_relaxed);
+                total += probabilities[c];
+            }
+            if (total == 0)
+                continue;
+            for (double& p : probabilities)
+                p /= total;
+            table.setRow(handClass, swaps, probabilities);
+        }
+    }
+    return table;
+}
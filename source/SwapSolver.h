@@ -0,0 +1,66 @@
+#ifndef SWAPSOLVER_H
+#define SWAPSOLVER_H
+
+#include "StrategyTable.h"
+#include "HandAbstraction.h"
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+#include <memory>
+
+// Offline counterfactual regret minimisation for the swap phase of a round.
+//
+// A round is modelled as a zero-sum game under the real rules: both seats get
+// five cards from one 52-card deck, the player swaps up to three cards, and,
+// if the player swapped, the computer (seeing its own hand and how many cards
+// were swapped) stands or swaps one card; the better hand scores +1. Hands
+// are abstracted with HandAbstraction, giving the player 134,459 information
+// sets and the computer three times as many. Rounds are treated independently:
+// earlier rounds' cards are not removed from the deck.
+//
+// Iterations use external-sampling Monte Carlo CFR and alternate the updated
+// seat. Worker threads traverse in parallel and write shared regrets with
+// relaxed atomics; a lost update is rare and only adds noise. Regrets are
+// regret-matching+ integers, one contiguous row per information set, so each
+// node costs one or two cache lines.
+class SwapSolver {
+public:
+    static constexpr int PlayerActions = 26;       // Every subset of at most three of the five cards
+    static constexpr int ComputerActions = StrategyTable::Actions;
+    static constexpr int Observations = StrategyTable::Observations;
+
+    explicit SwapSolver(int threads);
+
+    void run(quint64 count);                       // Run count more iterations across all threads
+    quint64 iterations() const;                    // Iterations completed so far
+    double playerValue() const;                    // Player's mean utility during the last run (+1 win, -1 loss)
+
+    bool saveCheckpoint(const QString& path) const; // Write regrets and strategy sums atomically
+    bool loadCheckpoint(const QString& path);      // Resume from a checkpoint (false if missing or invalid)
+    StrategyTable computerStrategy() const;        // Average computer strategy so far
+
+private:
+    struct Worker;
+
+    static constexpr int Classes = HandAbstraction::Classes;
+    static constexpr quint32 Magic = 0x504b4346;   // "PKCF"
+    static constexpr quint32 Version = 1;
+    static constexpr int RegretScale = 1024;       // Fixed-point scale of a utility of 1
+    static constexpr qint32 RegretCap = 1 << 30;   // Saturate rather than overflow
+
+    int threads;
+    quint64 completed = 0;
+    double lastValue = 0;
+
+    std::unique_ptr<std::atomic<qint32>[]> playerRegrets;    // Classes x PlayerActions
+    std::unique_ptr<std::atomic<qint32>[]> computerRegrets;  // Classes x Observations x ComputerActions
+    std::unique_ptr<std::atomic<quint32>[]> computerCounts;  // Sampled computer actions (average strategy)
+
+    void traversePlayer(Worker& worker);           // Update the player's regrets for one sampled deal
+    void traverseComputer(Worker& worker);         // Update the computer's regrets for one sampled deal
+
+    static void addRegret(std::atomic<qint32>& regret, double delta);
+    static size_t computerRow(int handClass, int playerSwaps); // Offset of a computer row
+};
+
+#endif // SWAPSOLVER_H
@@ -0,0 +1,230 @@
+#include "TableWidget.h"
+#include "AllocProfiler.h"
+#include <QPainter>
+#include <QPaintEvent>
+#include <QMouseEvent>
+#include <algorithm>
+
+// Constructor: start the animation clock and hook up the frame timer
+TableWidget::TableWidget(QWidget *parent) : QWidget(parent) {
+    frameTimer.setTimerType(Qt::PreciseTimer);
+    frameTimer.setInterval(16);
+    connect(&frameTimer, &QTimer::timeout, this, &TableWidget::onFrame);
+    clock.start();
+}
+
+// Replace the shown hands; cards that differ from before are dealt in if animate is set
+void TableWidget::setSeats(const QVector<Seat>& newSeats, bool animate) {
+    qint64 now = clock.elapsed();
+    int seatCount = newSeats.size();
+
+    int maxCards = 0;
+    dealStart.resize(seatCount);
+    for (int s = 0; s < seatCount; ++s) {
+        dealStart[s] = QVector<qint64>(static_cast<int>(newSeats[s].cards.size()), -1);
+        maxCards = std::max(maxCards, static_cast<int>(newSeats[s].cards.size()));
+    }
+
+    // Deal round-robin like a real dealer: card 0 of every seat, then card 1...
+    int order = 0;
+    for (int i = 0; i < maxCards && animate; ++i) {
+        for (int s = 0; s < seatCount; ++s) {
+            const auto& cards = newSeats[s].cards;
+            if (i >= static_cast<int>(cards.size()))
+                continue;
+            bool changed = s >= seats.size() || i >= static_cast<int>(seats[s].cards.size())
+                           || seats[s].cards[i].getNumber() != cards[i].getNumber();
+            if (changed)
+                dealStart[s][i] = now + DealStagger * order++;
+        }
+    }
+
+    bool resized = seats.size() != seatCount;
+    seats = newSeats;
+    if (resized)
+        updateGeometry();
+    if (order > 0)
+        frameTimer.start();
+    update();
+}
+
+// Set the result line shown under the hands
+void TableWidget::setResult(const QString& text) {
+    result = text;
+    update();
+}
+
+// Choose which seat's cards react to clicks
+void TableWidget::setSelectableSeat(int seat) {
+    selectableSeat = seat;
+    clearSelection();
+}
+
+// Get indices of the selected cards in ascending order
+QVector<int> TableWidget::selectedCards() const {
+    QVector<int> indices;
+    for (int i = 0; i < 32; ++i) {
+        if (selection & (1u << i))
+            indices.append(i);
+    }
+    return indices;
+}
+
+// Unselect all cards
+void TableWidget::clearSelection() {
+    selection = 0;
+    update();
+}
+
+// Preferred size: room for the widest hand and every seat
+QSize TableWidget::sizeHint() const {
+    int maxCards = 5;
+    for (const Seat& seat : seats)
+        maxCards = std::max(maxCards, static_cast<int>(seat.cards.size()));
+    int seatCount = std::max(2, static_cast<int>(seats.size()));
+    return QSize(Gap + maxCards * (CardWidth + Gap) + CardWidth + Gap,
+                 seatCount * seatHeight() + ResultHeight);
+}
+
+// Draw all seats and the result in a single pass
+void TableWidget::paintEvent(QPaintEvent *event) {
+    ALLOC_PHASE(Render);
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform);
+
+    qreal ratio = devicePixelRatioF();
+    if (ratio != spriteRatio) {
+        sprites.clear();
+        spriteRatio = ratio;
+        backSprite = loadSprite(":/cards/images/back.png");
+    }
+
+    qint64 now = clock.elapsed();
+    QFont headerFont = font();
+    headerFont.setBold(true);
+    QFont nameFont = font();
+    nameFont.setPointSizeF(font().pointSizeF() * 0.85);
+    QFontMetrics nameMetrics(nameFont);
+    QPoint deck = deckPosition();
+
+    for (int s = 0; s < seats.size(); ++s) {
+        QRect seatRect(0, s * seatHeight(), width(), seatHeight());
+        if (!event->rect().intersects(seatRect))
+            continue;
+
+        const Seat& seat = seats[s];
+        painter.setFont(headerFont);
+        painter.setPen(palette().color(QPalette::WindowText));
+        QString header = seat.category.isEmpty() ? seat.name : seat.name + ": " + seat.category;
+        painter.drawText(QRect(Gap, seatRect.top(), width() - 2 * Gap, HeaderHeight), Qt::AlignCenter, header);
+
+        painter.setFont(nameFont);
+        for (int i = 0; i < static_cast<int>(seat.cards.size()); ++i) {
+            QRect target = cardRect(s, i);
+            qint64 start = dealStart[s][i];
+
+            if (start >= 0 && now < start + DealDuration) {
+                if (now <= start)
+                    continue;  // Not dealt yet
+
+                // Ease out from the deck to the slot, face down until it lands
+                double t = double(now - start) / DealDuration;
+                t = 1.0 - (1.0 - t) * (1.0 - t);
+                QPoint pos = deck + (target.topLeft() - deck) * t;
+                painter.drawPixmap(pos, backSprite);
+                continue;
+            }
+
+            painter.drawPixmap(target.topLeft(), sprite(seat.cards[i]));
+
+            if (s == selectableSeat && (selection & (1u << i))) {
+                painter.setPen(QPen(palette().color(QPalette::Highlight), 3));
+                painter.drawRect(target.adjusted(-2, -2, 2, 2));
+                painter.setPen(palette().color(QPalette::WindowText));
+            }
+
+            QRect nameRect(target.left() - Gap / 2, target.bottom() + 2, CardWidth + Gap, NameHeight);
+            painter.drawText(nameRect, Qt::AlignCenter,
+                             nameMetrics.elidedText(seat.cards[i].getName(), Qt::ElideRight, nameRect.width()));
+        }
+    }
+
+    QRect resultRect(0, seats.size() * seatHeight(), width(), ResultHeight);
+    if (!result.isEmpty() && event->rect().intersects(resultRect)) {
+        painter.setFont(headerFont);
+        painter.setPen(palette().color(QPalette::WindowText));
+        painter.drawText(resultRect, Qt::AlignCenter, result);
+    }
+}
+
+// Toggle selection of a clicked card in the selectable seat
+void TableWidget::mousePressEvent(QMouseEvent *event) {
+    if (selectableSeat < 0 || selectableSeat >= seats.size())
+        return;
+
+    int count = static_cast<int>(seats[selectableSeat].cards.size());
+    for (int i = 0; i < count; ++i) {
+        QRect rect = cardRect(selectableSeat, i);
+        if (rect.contains(event->position().toPoint())) {
+            selection ^= (1u << i);
+            update(rect.adjusted(-4, -4, 4, 4));
+            return;
+        }
+    }
+}
+
+// Get the cached sprite for a card, scaling it for the current pixel ratio on first use
+const QPixmap& TableWidget::sprite(const Card& card) {
+    auto it = sprites.find(card.getNumber());
+    if (it == sprites.end())
+        it = sprites.insert(card.getNumber(), loadSprite(card.getImagePath()));
+    return *it;
+}
+
+// Load an image and scale it to the card size in device pixels
+QPixmap TableWidget::loadSprite(const QString& path) const {
+    QPixmap pix(path);
+    if (pix.isNull())
+        return pix;
+    pix = pix.scaled(QSize(CardWidth, CardHeight) * spriteRatio, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    pix.setDevicePixelRatio(spriteRatio);
+    return pix;
+}
+
+// Height of one seat row: header, cards and card names
+int TableWidget::seatHeight() const {
+    return HeaderHeight + CardHeight + NameHeight + Gap;
+}
+
+// Position of a card slot, hands centred horizontally
+QRect TableWidget::cardRect(int seat, int index) const {
+    int count = static_cast<int>(seats[seat].cards.size());
+    int total = count * CardWidth + (count - 1) * Gap;
+    int left = (width() - total) / 2;
+    return QRect(left + index * (CardWidth + Gap), seat * seatHeight() + HeaderHeight, CardWidth, CardHeight);
+}
+
+// Where dealt cards start their flight: the right edge, vertically centred
+QPoint TableWidget::deckPosition() const {
+    return QPoint(width() - Gap - CardWidth, (height() - CardHeight) / 2);
+}
+
+// Repaint while any card is still moving, then stop the timer
+void TableWidget::onFrame() {
+    qint64 now = clock.elapsed();
+    bool moving = false;
+    for (auto& seatStarts : dealStart) {
+        for (qint64& start : seatStarts) {
+            if (start < 0)
+                continue;
+            if (now < start + DealDuration)
+                moving = true;
+            else
+                start = -1;
+        }
+    }
+
+    if (!moving)
+        frameTimer.stop();
+    update();
+}
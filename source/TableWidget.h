@@ -0,0 +1,71 @@
+#ifndef TABLEWIDGET_H
+#define TABLEWIDGET_H
+
+#include "Card.h"
+#include <QWidget>
+#include <QHash>
+#include <QPixmap>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QVector>
+#include <vector>
+
+// Draws every seat's hand, the names and the round result in one paintEvent.
+// Card sprites are scaled once per device pixel ratio and cached, so a repaint
+// is a handful of pixmap blits instead of a relayout of per-card labels.
+class TableWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    struct Seat {
+        QString name;             // e.g., "You"
+        QString category;         // e.g., "Two Pair"
+        std::vector<Card> cards;  // Cards shown left to right
+    };
+
+    explicit TableWidget(QWidget *parent = nullptr);
+
+    void setSeats(const QVector<Seat>& newSeats, bool animate); // Show hands (animate changed cards)
+    void setResult(const QString& text);                        // Show the round result line
+    void setSelectableSeat(int seat);                           // Seat whose cards can be clicked (-1 = none)
+    QVector<int> selectedCards() const;                         // Indices of clicked cards
+    void clearSelection();                                      // Unselect all cards
+
+    QSize sizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+
+private:
+    static constexpr int CardWidth = 100;
+    static constexpr int CardHeight = 145;
+    static constexpr int Gap = 12;
+    static constexpr int HeaderHeight = 24;
+    static constexpr int NameHeight = 20;
+    static constexpr int ResultHeight = 32;
+    static constexpr int DealStagger = 80;    // ms between consecutive cards
+    static constexpr int DealDuration = 250;  // ms for one card to travel
+
+    QVector<Seat> seats;
+    QVector<QVector<qint64>> dealStart;       // Per card: animation start (ms), -1 = in place
+    QString result;
+    int selectableSeat = -1;
+    quint32 selection = 0;                    // Bit i = card i of selectableSeat chosen
+
+    QHash<int, QPixmap> sprites;              // Card number -> scaled sprite
+    QPixmap backSprite;
+    qreal spriteRatio = 0;                    // Device pixel ratio the sprites were built for
+
+    QTimer frameTimer;                        // ~60 fps while cards are moving
+    QElapsedTimer clock;
+
+    const QPixmap& sprite(const Card& card);  // Get (or build) a cached sprite
+    QPixmap loadSprite(const QString& path) const;
+    int seatHeight() const;
+    QRect cardRect(int seat, int index) const;
+    QPoint deckPosition() const;
+    void onFrame();                           // Advance the deal animation
+};
+
+#endif // TABLEWIDGET_H
@@ -0,0 +1,22 @@
+#include "DeckBenchmark.h"
+#include <QCoreApplication>
+#include <QTextStream>
+#include <thread>
+
+// Entry point of the deck benchmark: DeckBench [trials per thread] [threads]
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    quint64 trials = argc > 1 ? QString(argv[1]).toULongLong() : 1000000;
+    int threads = argc > 2 ? QString(argv[2]).toInt() : int(std::thread::hardware_concurrency());
+
+    QTextStream out(stdout);
+    out << "DeckBench: " << threads << " threads x " << trials << " trials" << Qt::endl;
+
+    DeckBenchmark bench(threads, trials);
+    for (bool bitDeck : { false, true }) {
+        out << DeckBenchmark::format(bench.runShuffle(bitDeck)) << Qt::endl;
+        out << DeckBenchmark::format(bench.runReturn(bitDeck)) << Qt::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,471 @@
+#include "BitDeck.h"
+#include "Game.h"
+#include "HandEvaluator.h"
+#include "HandOuts.h"
+#include "HandRanking.h"
+#include <cmath>
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
+// Regression checks for the hand engine against brute force and the baseline
+// (pre-optimisation) evaluation rules. Run by ctest; exits non-zero on failure.
+
+namespace {
+
+int failures = 0;
+
+// Report a failed check (only the first few per test are printed)
+void fail(const char* test, int& count, const QString& detail) {
+    if (++count <= 5)
+        std::printf("FAIL %s: %s\n", test, qPrintable(detail));
+    ++failures;
+}
+
+// Describe a hand as its Card::getNumber() codes
+QString describe(const std::vector<Card>& cards) {
+    QStringList codes;
+    for (const Card& c : cards)
+        codes << QString::number(c.getNumber());
+    return codes.join(" ");
+}
+
+// The baseline Hand rules for five natural cards: category, primary value,
+// kickers and group order. The only intended change since is that A-2-3-4-5
+// suited is a straight flush, not a royal flush.
+struct BaselineHand {
+    QString best;
+    int primary = 0;
+    std::vector<int> secondary;
+    std::vector<int> grouped;   // getNumber() codes after sortGroup
+
+    explicit BaselineHand(const std::vector<Card>& cards) {
+        int counts[15] = {0};
+        std::vector<int> vals;
+        for (const Card& c : cards) {
+            counts[c.getValue()]++;
+            vals.push_back(c.getValue());
+        }
+        std::sort(vals.begin(), vals.end());
+
+        bool flush = std::all_of(cards.begin(), cards.end(),
+                                 [&](const Card& c) { return c.getSuit() == cards[0].getSuit(); });
+        bool wheel = vals == std::vector<int>{2, 3, 4, 5, 14};
+        bool straight = wheel;
+        if (!wheel) {
+            straight = true;
+            for (int i = 0; i < 4; ++i)
+                straight = straight && vals[i + 1] == vals[i] + 1;
+        }
+
+        std::vector<int> freq;
+        for (int v = 2; v <= 14; ++v) {
+            if (counts[v])
+                freq.push_back(counts[v]);
+        }
+        std::sort(freq.rbegin(), freq.rend());
+
+        if (straight && flush && vals[0] == 10) best = "ryfl";
+        else if (straight && flush) best = "stfl";
+        else if (freq[0] == 4) best = "four";
+        else if (freq[0] == 3 && freq[1] == 2) best = "full";
+        else if (flush) best = "flsh";
+        else if (straight) best = "strt";
+        else if (freq[0] == 3) best = "trio";
+        else if (freq[0] == 2 && freq[1] == 2) best = "twop";
+        else if (freq[0] == 2) best = "pair";
+        else best = "high";
+
+        // Primary: the largest group's value (highest on ties), the straight's top card, or the high card
+        if (best == "ryfl" || best == "stfl" || best == "strt") {
+            primary = wheel ? 5 : vals.back();
+        } else {
+            for (int v = 14; v >= 2; --v) {
+                if (counts[v] == freq[0]) {
+                    primary = v;
+                    break;
+                }
+            }
+        }
+        for (int v = 14; v >= 2; --v) {
+            for (int i = 0; v != primary && i < counts[v]; ++i)
+                secondary.push_back(v);
+        }
+
+        // Groups by size, then value, both descending; cards keep their order within a group
+        std::vector<Card> order = cards;
+        std::stable_sort(order.begin(), order.end(), [&](const Card& a, const Card& b) {
+            if (counts[a.getValue()] != counts[b.getValue()])
+                return counts[a.getValue()] > counts[b.getValue()];
+            return a.getValue() > b.getValue();
+        });
+        for (const Card& c : order)
+            grouped.push_back(c.getNumber());
+    }
+};
+
+// Every five-card hand, in a varied card order, matches the baseline rules
+void testAllHandsMatchBaseline() {
+    int count = 0;
+    Hand hand;
+    std::vector<Card> cards(5);
+    int c[5];
+    for (c[0] = 0; c[0] < 52; ++c[0])
+    for (c[1] = c[0] + 1; c[1] < 52; ++c[1])
+    for (c[2] = c[1] + 1; c[2] < 52; ++c[2])
+    for (c[3] = c[2] + 1; c[3] < 52; ++c[3])
+    for (c[4] = c[3] + 1; c[4] < 52; ++c[4]) {
+        for (int i = 0; i < 5; ++i)
+            cards[i] = Card::fromIndex(c[(i * 3 + c[4]) % 5]);  // Vary the input order
+        BaselineHand expected(cards);
+        hand.setCards(cards);
+
+        Hand::Kickers kickers = hand.getSecondaryValues();
+        std::vector<int> secondary(kickers.begin(), kickers.end());
+        if (hand.getBest() != expected.best || hand.getPrimaryValue() != expected.primary
+            || secondary != expected.secondary) {
+            fail("baseline", count, describe(cards) + " -> " + hand.getBest());
+            continue;
+        }
+
+        hand.sortGroup();
+        std::vector<int> grouped;
+        for (const Card& card : hand.getCards())
+            grouped.push_back(card.getNumber());
+        if (grouped != expected.grouped)
+            fail("baseline sortGroup", count, describe(cards));
+    }
+    std::printf("baseline: 2598960 hands, %d failures\n", count);
+}
+
+// The best hand among all substitutions of jokers by any card, under Game::compareHands
+Hand bestSubstitution(std::vector<Card> cards) {
+    std::vector<int> wild;
+    for (size_t i = 0; i < cards.size(); ++i) {
+        if (cards[i].isJoker())
+            wild.push_back(int(i));
+    }
+
+    Hand best;
+    bool found = false;
+    std::function<void(size_t)> substitute = [&](size_t next) {
+        if (next == wild.size()) {
+            Hand trial;
+            trial.setCards(cards);
+            if (!found || Game::compareHands(trial, best) > 0) {
+                best = trial;
+                found = true;
+            }
+            return;
+        }
+        for (int index = 0; index < 52; ++index) {
+            cards[wild[next]] = Card::fromIndex(index);
+            substitute(next + 1);
+        }
+    };
+    substitute(0);
+    return best;
+}
+
+// Hands with one or two jokers score exactly like their best substitution
+void testJokersMatchBruteForce() {
+    int count = 0;
+    std::mt19937 rng(30);
+    for (int trial = 0; trial < 3000; ++trial) {
+        int jokers = 1 + trial % 2;
+        std::vector<int> deck(52);
+        for (int i = 0; i < 52; ++i)
+            deck[i] = i;
+        std::shuffle(deck.begin(), deck.end(), rng);
+
+        std::vector<Card> cards;
+        for (int i = 0; i < 5 - jokers; ++i)
+            cards.push_back(Card::fromIndex(deck[i]));
+        for (int j = 0; j < jokers; ++j)
+            cards.push_back(Card::fromIndex(52 + j));
+        std::shuffle(cards.begin(), cards.end(), rng);
+
+        Hand hand;
+        hand.setCards(cards);
+        Hand best = bestSubstitution(cards);
+        if (hand.getRankIndex() != best.getRankIndex() || Game::compareHands(hand, best) != 0)
+            fail("jokers", count, describe(cards) + " -> " + hand.getBest() + ", best " + best.getBest());
+    }
+    std::printf("jokers: 3000 hands, %d failures\n", count);
+}
+
+// The best five of seven cards under Game::compareHands, from all 21 subsets
+Hand bestOfSeven(const std::vector<Card>& cards) {
+    Hand best;
+    bool found = false;
+    for (int a = 0; a < 7; ++a) {
+        for (int b = a + 1; b < 7; ++b) {
+            std::vector<Card> five;
+            for (int i = 0; i < 7; ++i) {
+                if (i != a && i != b)
+                    five.push_back(cards[i]);
+            }
+            Hand trial;
+            trial.setCards(five);
+            if (!found || Game::compareHands(trial, best) > 0) {
+                best = trial;
+                found = true;
+            }
+        }
+    }
+    return best;
+}
+
+// Seven-card showdowns agree with comparing the best five of each hand
+void testHoldemMatchesBestOfSeven() {
+    int count = 0;
+    std::mt19937 rng(31);
+    std::vector<int> deck(52);
+    for (int trial = 0; trial < 50000; ++trial) {
+        for (int i = 0; i < 52; ++i)
+            deck[i] = i;
+        std::shuffle(deck.begin(), deck.end(), rng);
+
+        std::vector<Card> a, b;
+        for (int i = 0; i < 2; ++i) {
+            a.push_back(Card::fromIndex(deck[i]));
+            b.push_back(Card::fromIndex(deck[2 + i]));
+        }
+        for (int i = 0; i < 5; ++i) {
+            a.push_back(Card::fromIndex(deck[4 + i]));
+            b.push_back(Card::fromIndex(deck[4 + i]));
+        }
+
+        Hand handA, handB;
+        handA.setCards(a);
+        handB.setCards(b);
+        int direct = Game::compareHands(handA, handB);
+        if (direct != Game::compareHands(bestOfSeven(a), bestOfSeven(b)))
+            fail("holdem", count, describe(a) + " vs " + describe(b));
+    }
+    std::printf("holdem: 50000 showdowns, %d failures\n", count);
+}
+
+// Shoe hands with duplicate copies score like Hand; jokers beyond five cards are rejected
+void testShoeDuplicatesAndJokers() {
+    int count = 0;
+    std::mt19937 rng(31);
+    std::uniform_int_distribution<int> pick(0, 51);
+    for (int trial = 0; trial < 200000; ++trial) {
+        // Draw from a few suits and values so duplicates, flushes and big groups are common
+        std::vector<Card> cards;
+        for (int i = 0; i < 5; ++i) {
+            int index = pick(rng);
+            cards.push_back(Card::fromIndex(trial % 2 ? (index % 8) * 4 + index % 2 : index));
+        }
+        Hand hand;
+        hand.setCards(cards);
+        if (HandEvaluator::rankIndex(HandEvaluator::evaluate(cards.data(), 5)) != hand.getRankIndex())
+            fail("shoe", count, describe(cards) + " -> " + hand.getBest());
+    }
+
+    // K K 9 5 2 of spades (two decks) plus two off-suit cards is a flush, five Aces are five of a kind
+    std::vector<Card> flush = { Card(13, 4), Card(13, 4), Card(9, 4), Card(5, 4), Card(2, 4), Card(7, 1), Card(8, 2) };
+    if (HandEvaluator::rankIndex(HandEvaluator::evaluate(flush.data(), 7)) != Hand::categoryCodes().indexOf("flsh"))
+        fail("shoe", count, describe(flush) + " is not a flush");
+    std::vector<Card> five = { Card(14, 1), Card(14, 1), Card(14, 2), Card(14, 3), Card(14, 4), Card(7, 1), Card(8, 2) };
+    if (HandEvaluator::rankIndex(HandEvaluator::evaluate(five.data(), 7)) != Hand::categoryCodes().indexOf("five"))
+        fail("shoe", count, describe(five) + " is not five of a kind");
+
+    std::vector<Card> wild = { Card(14, 1), Card(13, 1), Card(12, 1), Card(11, 1), Card(Card::JokerValue, 1), Card(2, 2) };
+    Hand jokerHand;
+    jokerHand.setCards(wild);
+    if (HandEvaluator::evaluate(wild.data(), 6) != HandEvaluator::Invalid || jokerHand.getRankIndex() != -1)
+        fail("shoe", count, describe(wild) + " with a joker was scored");
+    std::printf("shoe: 200000 hands, %d failures\n", count);
+}
+
+// Decks take back only cards they have a copy of out, and never change size
+void testDecksReturnOnlyDealtCards() {
+    int count = 0;
+    Deck deck;
+    BitDeck bits;
+    Card ace(14, 4);
+    Card joker(Card::JokerValue, 1);
+    for (CardSource* source : { static_cast<CardSource*>(&deck), static_cast<CardSource*>(&bits) }) {
+        source->reset();
+        if (source->insertCardRandomly(ace) || source->cardsRemaining() != 52)
+            fail("returns", count, "a full deck took back a card");
+        Card dealt = source->dealCard();
+        if (source->insertCardRandomly(joker) || source->cardsRemaining() != 51)
+            fail("returns", count, "a deck without jokers took back a joker");
+        if (!source->insertCardRandomly(dealt) || source->cardsRemaining() != 52)
+            fail("returns", count, "a dealt card was not taken back");
+        if (source->insertCardRandomly(dealt) || source->cardsRemaining() != 52)
+            fail("returns", count, "a card was taken back twice");
+    }
+
+    // A two-deck shoe takes back both copies of a card, and no third
+    deck.setShoe(2, 1.0);
+    int first = -1, copies = 0;
+    while (deck.cardsRemaining() > 0 && copies < 2) {
+        Card card = deck.dealCard();
+        if (first < 0 || card.getIndex() == first) {
+            first = card.getIndex();
+            ++copies;
+        }
+    }
+    size_t remaining = deck.cardsRemaining();
+    Card card = Card::fromIndex(first);
+    if (!deck.insertCardRandomly(card) || !deck.insertCardRandomly(card) || deck.insertCardRandomly(card)
+        || deck.cardsRemaining() != remaining + 2 || deck.liveCount(quint64(1) << first) != 2)
+        fail("returns", count, "a shoe took back the wrong number of copies");
+    std::printf("returns: %d failures\n", count);
+}
+
+// Percentile counts and beaten-by counts agree with enumerating every hand
+void testRankingMatchesBruteForce() {
+    int count = 0;
+    std::mt19937 rng(40);
+    std::vector<int> deck(52);
+    for (int trial = 0; trial < 12; ++trial) {
+        for (int i = 0; i < 52; ++i)
+            deck[i] = i;
+        std::shuffle(deck.begin(), deck.end(), rng);
+
+        Card own[5];
+        std::vector<Card> ownCards, opponentCards;
+        quint64 visible = 0;
+        for (int i = 0; i < 5; ++i) {
+            own[i] = Card::fromIndex(deck[i]);
+            ownCards.push_back(own[i]);
+        }
+        bool withOpponent = trial % 3 != 0;  // Own cards only, or the opponent's hand face up
+        for (int i = 0; withOpponent && i < 5; ++i) {
+            opponentCards.push_back(Card::fromIndex(deck[5 + i]));
+            visible |= quint64(1) << deck[5 + i];
+        }
+        for (int i = 0; i < 5; ++i)
+            visible |= quint64(1) << deck[i];
+
+        quint32 strength = HandEvaluator::drawStrength(own);
+        quint64 weaker = 0, stronger = 0, beatenBy = 0, possible = 0;
+        Card cards[5];
+        int c[5];
+        for (c[0] = 0; c[0] < 52; ++c[0])
+        for (c[1] = c[0] + 1; c[1] < 52; ++c[1])
+        for (c[2] = c[1] + 1; c[2] < 52; ++c[2])
+        for (c[3] = c[2] + 1; c[3] < 52; ++c[3])
+        for (c[4] = c[3] + 1; c[4] < 52; ++c[4]) {
+            quint64 mask = 0;
+            for (int i = 0; i < 5; ++i) {
+                cards[i] = Card::fromIndex(c[i]);
+                mask |= quint64(1) << c[i];
+            }
+            quint32 other = HandEvaluator::drawStrength(cards);
+            weaker += other < strength;
+            stronger += other > strength;
+            if (!(mask & visible)) {
+                ++possible;
+                beatenBy += other > strength;
+            }
+        }
+
+        Hand hand, opponent;
+        hand.setCards(ownCards);
+        opponent.setCards(opponentCards);
+        HandRanking::Position position = withOpponent ? HandRanking::locate(hand, opponent)
+                                                      : HandRanking::locate(hand);
+        if (!position.valid || position.weaker != weaker || position.stronger != stronger
+            || position.beatenBy != beatenBy || position.possible != possible) {
+            fail("ranking", count, describe(ownCards) + QString(" beaten by %1, expected %2")
+                                                           .arg(position.beatenBy).arg(beatenBy));
+        }
+    }
+    std::printf("ranking: 12 hands, %d failures\n", count);
+}
+
+// Outs counts and expected gains agree with swapping every live card into every position
+void testOutsMatchBruteForce() {
+    int count = 0;
+    int checked = 0;
+    struct Setup { int decks; int jokers; };
+    const Setup setups[] = { { 1, 0 }, { 1, 2 }, { 4, 1 } };
+    for (const Setup& setup : setups) {
+        Deck deck;
+        deck.setJokers(setup.jokers);
+        if (setup.decks > 1)
+            deck.setShoe(setup.decks, 1.0);
+        for (int trial = 0; trial < 300; ++trial) {
+            deck.reset();
+            Hand hand, opponent;
+            hand.dealHand(deck);
+            opponent.dealHand(deck);
+            HandOuts outs;
+            outs.update(hand, deck);
+
+            // The opponent's swap returns a card (a full rescore), a deal only removes one (cached)
+            for (int step = 0; step < 3; ++step) {
+                if (step == 1)
+                    opponent.swapCard({trial % 5}, deck);
+                else if (step == 2)
+                    deck.dealCard();
+                outs.update(hand, deck);
+
+                const std::vector<Card>& cards = hand.getCards();
+                int current = hand.getRankIndex();
+                int expected[Hand::CategoryCount] = {0};
+                qint64 gain[HandOuts::Positions] = {0};
+                int live = deck.liveCount(deck.liveMask());
+                for (quint64 mask = deck.liveMask(); mask != 0; mask &= mask - 1) {
+                    int index = int(qCountTrailingZeroBits(mask));
+                    int copies = deck.liveCount(quint64(1) << index);
+                    int best = Hand::CategoryCount;
+                    for (int position = 0; position < HandOuts::Positions; ++position) {
+                        std::vector<Card> swapped = cards;
+                        swapped[position] = Card::fromIndex(index);
+                        Hand made;
+                        made.setCards(swapped);
+                        gain[position] += qint64(current - made.getRankIndex()) * copies;
+                        if (!cards[position].isJoker())
+                            best = std::min(best, made.getRankIndex());
+                    }
+                    if (best < current)
+                        expected[best] += copies;
+                }
+
+                int total = 0;
+                for (int category = 0; category < Hand::CategoryCount; ++category) {
+                    total += expected[category];
+                    if (outs.count(category, deck) != expected[category])
+                        fail("outs", count, describe(cards) + QString(" category %1: %2, expected %3")
+                                                                .arg(category).arg(outs.count(category, deck)).arg(expected[category]));
+                }
+                if (outs.total(deck) != total)
+                    fail("outs total", count, describe(cards));
+                for (int position = 0; position < HandOuts::Positions; ++position) {
+                    if (std::fabs(outs.expectedGain(position, deck) - double(gain[position]) / live) > 1e-9)
+                        fail("outs gain", count, describe(cards) + QString(" position %1").arg(position));
+                }
+                ++checked;
+            }
+        }
+    }
+    std::printf("outs: %d hands, %d failures\n", checked, count);
+}
+
+} // namespace
+
+int main() {
+    testAllHandsMatchBaseline();
+    testJokersMatchBruteForce();
+    testHoldemMatchesBestOfSeven();
+    testShoeDuplicatesAndJokers();
+    testDecksReturnOnlyDealtCards();
+    testRankingMatchesBruteForce();
+    testOutsMatchBruteForce();
+
+    if (failures > 0) {
+        std::printf("%d checks failed\n", failures);
+        return 1;
+    }
+    std::printf("All engine tests passed\n");
+    return 0;
+}
@@ -0,0 +1,23 @@
+#include "BulkEvaluator.h"
+#include <QCoreApplication>
+#include <QTextStream>
+#include <thread>
+
+// Entry point of the bulk hand evaluator:
+// HandEval <input> <output> [threads] [cards per binary record, 0 = text]
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QTextStream out(stdout);
+    if (argc < 3) {
+        out << "Usage: HandEval <input> <output> [threads] [cards per binary record, 0 = text]" << Qt::endl;
+        return 2;
+    }
+    int threads = argc > 3 ? QString(argv[3]).toInt() : int(std::thread::hardware_concurrency());
+    int recordCards = argc > 4 ? QString(argv[4]).toInt() : 0;
+
+    BulkEvaluator evaluator(threads, recordCards);
+    BulkEvaluator::Result result = evaluator.run(argv[1], argv[2]);
+    out << BulkEvaluator::format(result) << Qt::endl;
+    return result.ok ? 0 : 1;
+}
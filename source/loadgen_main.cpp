@@ -0,0 +1,17 @@
+#include "LoadGenerator.h"
+#include <QCoreApplication>
+
+// Entry point of the load generator: PokerLoadGen [players] [actions per player] [port] [host]
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    int players = argc > 1 ? QString(argv[1]).toInt() : 1000;
+    int actions = argc > 2 ? QString(argv[2]).toInt() : 100;
+    quint16 port = argc > 3 ? QString(argv[3]).toUShort() : 5282;
+    QString host = argc > 4 ? QString(argv[4]) : QString("127.0.0.1");
+
+    LoadGenerator generator(host, port, players, actions);
+    QObject::connect(&generator, &LoadGenerator::finished, &app, &QCoreApplication::quit);
+    generator.start();
+    return app.exec();
+}
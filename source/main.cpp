@@ -1,10 +1,12 @@
 #include "mainwindow.h"
+#include "HandRanking.h"
 #include <QApplication>
 
 // Entry point of the application
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);  // Initialize Qt application
+    HandRanking::prepare();      // Build the hand ranking tables before the event loop starts
     MainWindow w;                // Create main window instance
     w.show();                    // Show the main window
     return a.exec();             // Start the event loop
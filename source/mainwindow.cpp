@@ -1,11 +1,18 @@
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
+#include "Statistics.h"
+#include "AllocProfiler.h"
+#include "HandRanking.h"
+#include <QCoreApplication>
 #include <QMap>
 #include <QString>
+#include <QStringList>
+#include <QTableWidgetItem>
 
 // Convert hand type code to readable name
 QString prettifyCategory(const QString& code) {
     static QMap<QString, QString> map = {
+        {"five", "Five of a Kind"},
         {"ryfl", "Royal Flush"},
         {"stfl", "Straight Flush"},
         {"four", "Four of a Kind"},
@@ -26,6 +33,22 @@ MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent), ui(new Ui::MainWindow) {
     ui->setupUi(this);
     ui->btnNext->setEnabled(false);
+    ui->table->setSelectableSeat(1);
+
+    // Solved computer swaps, if SwapSolver's table ships next to the executable
+    game.loadComputerStrategy(QCoreApplication::applicationDirPath() + "/swap_strategy.bin");
+
+    // Matchup grid: rows = your category, columns = computer category
+    QStringList headers;
+    for (const QString& code : Hand::categoryCodes())
+        headers << prettifyCategory(code);
+    ui->tableMatchups->setRowCount(Statistics::Categories);
+    ui->tableMatchups->setColumnCount(Statistics::Categories);
+    ui->tableMatchups->setVerticalHeaderLabels(headers);
+    ui->tableMatchups->setHorizontalHeaderLabels(headers);
+
+    connect(&statsTimer, &QTimer::timeout, this, &MainWindow::updateStatsPanel);
+    statsTimer.start(500);
 }
 
 // Destructor: cleanup
@@ -35,10 +58,21 @@ MainWindow::~MainWindow() {
 
 // Start Game button clicked
 void MainWindow::on_btnStart_clicked() {
+    // Hold'em has no swaps and no jokers
+    bool holdem = ui->checkHoldem->isChecked();
+    game.setHoldem(holdem);
+    // A shoe reshuffles at the cut card instead of ending the game
+    if (ui->checkShoe->isChecked())
+        game.getDeck().setShoe(ui->spinDecks->value(), ui->spinPenetration->value() / 100.0);
+    else
+        game.getDeck().setSingleDeck();
+    game.getDeck().setJokers(holdem ? 0 : ui->spinJokers->value());
+    ui->table->setSelectableSeat(holdem ? -1 : 1);
+    ui->btnSwap->setEnabled(!holdem);
     game.startGame();
 
     if (!game.dealNextRound()) {
-        ui->labelResult->setText("Deck has fewer than 10 cards — cannot deal.");
+        ui->table->setResult("Not enough cards left for a round — cannot deal.");
         ui->btnNext->setEnabled(false);
         return;
     }
@@ -52,21 +86,22 @@ void MainWindow::on_btnStart_clicked() {
 // Next Round / Finish Game button clicked
 void MainWindow::on_btnNext_clicked() {
     if (ui->btnNext->text() == "FINISH GAME") {
-        ui->labelResult->setText("Game Over. " + game.overallWinner().getName() + " wins! Click 'START' to play again.");
+        game.closeRound();
+        ui->table->setResult("Game Over. " + game.overallWinner().getName() + " wins! Click 'START' to play again.");
         ui->btnNext->setEnabled(false);
         return;
     }
 
     if (!game.dealNextRound()) {
-        ui->labelResult->setText("Deck has fewer than 10 cards — press FINISH GAME.");
+        ui->table->setResult("Not enough cards left for a round — press FINISH GAME.");
         ui->btnNext->setText("FINISH GAME");
         return;
     }
 
     if (game.wasDraw()) {
-        ui->labelResult->setText("Draw!");
+        ui->table->setResult("Draw!");
     } else {
-        ui->labelResult->setText("Round Winner: " + game.winnerOfRound()->getName());
+        ui->table->setResult("Round Winner: " + game.winnerOfRound()->getName());
     }
 
     updateDisplay();
@@ -74,35 +109,18 @@ void MainWindow::on_btnNext_clicked() {
 
 // Swap button clicked: player swaps selected cards
 void MainWindow::on_btnSwap_clicked() {
-    QVector<int> indices;
-    if (ui->checkCard1->isChecked()) indices.append(0);
-    if (ui->checkCard2->isChecked()) indices.append(1);
-    if (ui->checkCard3->isChecked()) indices.append(2);
-    if (ui->checkCard4->isChecked()) indices.append(3);
-    if (ui->checkCard5->isChecked()) indices.append(4);
-
+    QVector<int> indices = ui->table->selectedCards();
     if (indices.isEmpty()) return;
 
     game.playerSwapCards(indices);
     game.evaluateHands();
     updateDisplay();
-
-    // Uncheck all boxes
-    ui->checkCard1->setChecked(false);
-    ui->checkCard2->setChecked(false);
-    ui->checkCard3->setChecked(false);
-    ui->checkCard4->setChecked(false);
-    ui->checkCard5->setChecked(false);
+    ui->table->clearSelection();
 }
 
-// Update all UI displays
-void MainWindow::updateDisplay() {
-    QString playerCategory = prettifyCategory(game.getPlayer().getHand().getBest());
-    QString computerCategory = prettifyCategory(game.getComputer().getHand().getBest());
-
-    ui->labelPlayerCategory->setText("Your Hand: " + playerCategory);
-    ui->labelComputerCategory->setText("Computer Hand: " + computerCategory);
-
+// Update all UI displays; newly dealt cards fly in when animate is set
+void MainWindow::updateDisplay(bool animate) {
+    ALLOC_PHASE(Render);
     ui->labelScore->setText(
         QString("Round %1 | You: %2   Computer: %3")
             .arg(game.currentRound())
@@ -111,51 +129,97 @@ void MainWindow::updateDisplay() {
         );
 
     if (game.wasDraw() || game.winnerOfRound() == nullptr) {
-        ui->labelResult->setText("Round Result: Draw");
+        ui->table->setResult("Round Result: Draw");
     } else {
-        ui->labelResult->setText("Round Winner: " + game.winnerOfRound()->getName());
+        ui->table->setResult("Round Winner: " + game.winnerOfRound()->getName());
     }
 
-    updatePlayerHandImages();
-    updateComputerHandImages();
+    updateTable(animate);
 }
 
-// Show player's cards and labels
-void MainWindow::updatePlayerHandImages() {
-    const auto& cards = game.getPlayer().getHand().getCards();
-
-    QVector<QLabel*> imageLabels = {
-        ui->labelCard1, ui->labelCard2, ui->labelCard3,
-        ui->labelCard4, ui->labelCard5
-    };
-    QVector<QLabel*> nameLabels = {
-        ui->labelCard1Name, ui->labelCard2Name, ui->labelCard3Name,
-        ui->labelCard4Name, ui->labelCard5Name
-    };
-
-    for (int i = 0; i < cards.size(); ++i) {
-        QPixmap pix(cards[i].getImagePath());
-        imageLabels[i]->setPixmap(pix.scaled(100, 140, Qt::KeepAspectRatio));
-        nameLabels[i]->setText(cards[i].getName());
+// Show both hands, computer on top and player at the bottom (Hold'em: board in between)
+void MainWindow::updateTable(bool animate) {
+    QVector<TableWidget::Seat> seats;
+    Player* players[] = { &game.getComputer(), &game.getPlayer() };
+    for (int i = 0; i < 2; ++i) {
+        Hand& hand = players[i]->getHand();
+        std::vector<Card> shown = hand.getCards();
+        QString category = prettifyCategory(hand.getBest());
+        if (game.isHoldem()) {
+            shown.resize(2);  // Hole cards only; the board is its own row
+        } else {
+            // Draw: both hands are face up, so the other one is out of the opponent's reach
+            HandRanking::Position position = HandRanking::locate(hand, players[1 - i]->getHand());
+            if (position.valid) {
+                category += QString(" · top %1% · beaten by %2 of %3")
+                                .arg(100.0 - position.percentile(), 0, 'f', 2)
+                                .arg(position.beatenBy)
+                                .arg(position.possible);
+            }
+
+            // Live cards that would lift the hand to each stronger category if swapped in
+            const HandOuts& outs = game.outsOf(*players[i]);
+            QStringList improvements;
+            for (int c = 0; c < outs.category(); ++c) {
+                int count = outs.count(c, game.getDeck());
+                if (count > 0)
+                    improvements << QString("%1 %2").arg(count).arg(prettifyCategory(Hand::categoryCodes()[c]));
+            }
+            if (!improvements.isEmpty())
+                category += " · outs: " + improvements.join(", ");
+        }
+        seats.append({ players[i]->getName(), category, shown });
     }
+    if (game.isHoldem())
+        seats.insert(1, { "Board", QString(), game.getBoard() });
+    ui->table->setSeats(seats, animate);
 }
 
-// Show computer's cards and labels
-void MainWindow::updateComputerHandImages() {
-    const auto& cards = game.getComputer().getHand().getCards();
+// Show category frequencies, swap results and the win/draw matchup grid
+void MainWindow::updateStatsPanel() {
+    Statistics::Snapshot stats = Statistics::instance().snapshot();
+    if (stats.rounds == 0)
+        return;
 
-    QVector<QLabel*> imageLabels = {
-        ui->labelCompCard1, ui->labelCompCard2, ui->labelCompCard3,
-        ui->labelCompCard4, ui->labelCompCard5
-    };
-    QVector<QLabel*> nameLabels = {
-        ui->labelCompCard1Name, ui->labelCompCard2Name, ui->labelCompCard3Name,
-        ui->labelCompCard4Name, ui->labelCompCard5Name
+    auto percent = [](quint64 part, quint64 whole) {
+        return whole == 0 ? QString("-") : QString::number(100.0 * part / whole, 'f', 1) + "%";
     };
 
-    for (int i = 0; i < cards.size(); ++i) {
-        QPixmap pix(cards[i].getImagePath());
-        imageLabels[i]->setPixmap(pix.scaled(100, 140, Qt::KeepAspectRatio));
-        nameLabels[i]->setText(cards[i].getName());
+    QStringList lines;
+    lines << QString("Rounds: %1").arg(stats.rounds);
+
+    const QString seatNames[Statistics::Seats] = { "You", "Computer" };
+    for (int seat = 0; seat < Statistics::Seats; ++seat) {
+        QStringList freq;
+        for (int c = 0; c < Statistics::Categories; ++c) {
+            if (stats.categories[seat][c] > 0)
+                freq << prettifyCategory(Hand::categoryCodes()[c]) + " " + percent(stats.categories[seat][c], stats.rounds);
+        }
+        lines << QString("%1: %2 | Swaps: %3, improved %4")
+                     .arg(seatNames[seat], freq.join(", "))
+                     .arg(stats.swaps[seat])
+                     .arg(percent(stats.improvingSwaps[seat], stats.swaps[seat]));
+    }
+    if (AllocProfiler::enabled())
+        lines << AllocProfiler::report();
+    ui->labelStats->setText(lines.join("\n"));
+
+    for (int a = 0; a < Statistics::Categories; ++a) {
+        for (int b = 0; b < Statistics::Categories; ++b) {
+            const quint64* outcomes = stats.matchups[a][b];
+            quint64 total = outcomes[Statistics::Win] + outcomes[Statistics::Draw] + outcomes[Statistics::Loss];
+            QString text;
+            if (total > 0)
+                text = QString("W %1 D %2").arg(percent(outcomes[Statistics::Win], total),
+                                                 percent(outcomes[Statistics::Draw], total));
+
+            QTableWidgetItem* item = ui->tableMatchups->item(a, b);
+            if (!item) {
+                item = new QTableWidgetItem;
+                ui->tableMatchups->setItem(a, b, item);
+            }
+            item->setText(text);
+            item->setToolTip(QString("%1 rounds").arg(total));
+        }
     }
 }
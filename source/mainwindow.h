@@ -3,6 +3,7 @@
 
 #include <QMainWindow>
 #include <qlabel.h>
+#include <QTimer>
 #include "Game.h"
 
 QT_BEGIN_NAMESPACE
@@ -24,10 +25,11 @@ private slots:
 private:
     Ui::MainWindow *ui;
     Game game;
+    QTimer statsTimer;               // Refreshes the statistics panel
 
-    void updateDisplay();            // Refresh all UI elements
-    void updatePlayerHandImages();   // Show player's cards and names
-    void updateComputerHandImages(); // Show computer's cards and names
+    void updateDisplay(bool animate = true); // Refresh all UI elements
+    void updateTable(bool animate);  // Show both hands on the table widget
+    void updateStatsPanel();         // Show aggregated statistics from all threads
 };
 
 #endif // MAINWINDOW_H
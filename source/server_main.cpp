@@ -0,0 +1,30 @@
+#include "GameServer.h"
+#include "HandRanking.h"
+#include <QCoreApplication>
+#include <QTextStream>
+
+// Entry point of the headless game server:
+// PokerServer [--rank] [port] [shoe decks] [penetration]
+// --rank adds HandRanking percentiles and beaten-by counts to every response
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QStringList args = app.arguments().mid(1);
+    bool ranking = args.removeAll("--rank") > 0;
+    quint16 port = args.size() > 0 ? args[0].toUShort() : 5282;
+
+    GameServer server;
+    if (ranking) {
+        HandRanking::prepare();  // Build the hand ranking tables before serving
+        server.setRanking(true);
+    }
+    if (args.size() > 1)
+        server.setShoe(args[1].toInt(), args.size() > 2 ? args[2].toDouble() : 0.75);
+    if (!server.listen(port)) {
+        QTextStream(stderr) << "Cannot listen on port " << port << "\n";
+        return 1;
+    }
+
+    QTextStream(stdout) << "PokerServer listening on 127.0.0.1:" << port << Qt::endl;
+    return app.exec();
+}
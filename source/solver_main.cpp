@@ -0,0 +1,47 @@
+#include "SwapSolver.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <thread>
+
+// Entry point of the swap solver:
+// SwapSolver [iterations] [threads] [checkpoint file] [strategy file]
+// Resumes from the checkpoint if present, saves it after every batch, and
+// writes the computer's average strategy for Game::loadComputerStrategy.
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    quint64 total = argc > 1 ? QString(argv[1]).toULongLong() : 100000000;
+    int threads = argc > 2 ? QString(argv[2]).toInt() : int(std::thread::hardware_concurrency());
+    QString checkpoint = argc > 3 ? QString(argv[3]) : QString("swap_solver.ckpt");
+    QString output = argc > 4 ? QString(argv[4]) : QString("swap_strategy.bin");
+    const quint64 batch = 10000000;
+
+    QTextStream out(stdout);
+    SwapSolver solver(threads);
+    if (solver.loadCheckpoint(checkpoint))
+        out << "Resumed " << checkpoint << " at " << solver.iterations() << " iterations" << Qt::endl;
+
+    while (solver.iterations() < total) {
+        quint64 count = std::min(batch, total - solver.iterations());
+        QElapsedTimer timer;
+        timer.start();
+        solver.run(count);
+        double seconds = timer.nsecsElapsed() / 1e9;
+
+        if (!solver.saveCheckpoint(checkpoint))
+            out << "Could not write " << checkpoint << Qt::endl;
+        out << QString("%1 iterations  %2 it/s  player value %3")
+                   .arg(solver.iterations())
+                   .arg(count / seconds, 0, 'f', 0)
+                   .arg(solver.playerValue(), 0, 'f', 4)
+            << Qt::endl;
+    }
+
+    if (!solver.computerStrategy().save(output)) {
+        out << "Could not write " << output << Qt::endl;
+        return 1;
+    }
+    out << "Strategy written to " << output << Qt::endl;
+    return 0;
+}